@@ -0,0 +1,428 @@
+#ifndef ARCHIVE_READER_H
+#define ARCHIVE_READER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+// Incremental tar / zip extractor for archives that arrive in chunks of any
+// size. feed() returns each entry as soon as its last byte is in, so entries
+// can be recognized while the rest of the archive is still uploading. Only
+// the current entry is buffered.
+//
+// tar: ustar, GNU long names ('L') and pax paths ('x'); non-file entries
+// are skipped. zip: stored and deflated entries, zip64 sizes, and deflated
+// entries streamed with a trailing data descriptor.
+class ArchiveReader {
+public:
+    struct Entry {
+        std::string name;
+        std::string data;
+        std::string error;  // set, with empty data, when the entry is skipped
+    };
+
+    explicit ArchiveReader(size_t max_entry_bytes)
+        : max_entry_bytes_(max_entry_bytes), window_(64 * 1024) {}
+
+    ~ArchiveReader() { endInflate(); }
+
+    ArchiveReader(const ArchiveReader&) = delete;
+    ArchiveReader& operator=(const ArchiveReader&) = delete;
+
+    // Returns false once the archive is malformed; error() says why.
+    bool feed(const void* data, size_t size, std::vector<Entry>& entries) {
+        if (!error_.empty()) return false;
+        if (finished_) return true;  // bytes after the end marker are ignored
+        buffer_.append(static_cast<const char*>(data), size);
+        while (error_.empty() && !finished_ && step(entries)) {}
+        if (offset_ > 0 && offset_ * 2 >= buffer_.size()) {
+            buffer_.erase(0, offset_);
+            offset_ = 0;
+        }
+        return error_.empty();
+    }
+
+    // True after the end-of-archive marker, or when the input stopped
+    // cleanly between two entries (tar writers may omit the zero blocks).
+    bool complete() const {
+        if (finished_) return true;
+        return error_.empty() && available() == 0 &&
+               (state_ == State::TarHeader || state_ == State::ZipHeader);
+    }
+
+    const std::string& error() const { return error_; }
+
+private:
+    enum class State { Detect, TarHeader, TarData, ZipHeader, ZipStored, ZipInflate,
+                       ZipDescriptor, Skip };
+
+    static constexpr size_t kTarBlock = 512;
+    static constexpr size_t kMaxMetadataBytes = 1024 * 1024;
+    static constexpr uint32_t kZipLocalHeader = 0x04034b50;
+    static constexpr uint32_t kZipCentralHeader = 0x02014b50;
+    static constexpr uint32_t kZipEndRecord = 0x06054b50;
+    static constexpr uint32_t kZip64EndRecord = 0x06064b50;
+    static constexpr uint32_t kZipDescriptor = 0x08074b50;
+
+    size_t available() const { return buffer_.size() - offset_; }
+    const unsigned char* head() const {
+        return reinterpret_cast<const unsigned char*>(buffer_.data()) + offset_;
+    }
+
+    static uint16_t le16(const unsigned char* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    static uint32_t le32(const unsigned char* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+    static uint64_t le64(const unsigned char* p) {
+        return static_cast<uint64_t>(le32(p)) | (static_cast<uint64_t>(le32(p + 4)) << 32);
+    }
+
+    bool fail(const std::string& message) {
+        error_ = message;
+        return false;
+    }
+
+    // Returns true when it consumed input or changed state.
+    bool step(std::vector<Entry>& entries) {
+        switch (state_) {
+        case State::Detect: return detect();
+        case State::TarHeader: return tarHeader(entries);
+        case State::TarData: return tarData(entries);
+        case State::ZipHeader: return zipHeader(entries);
+        case State::ZipStored: return zipStored(entries);
+        case State::ZipInflate: return zipInflate(entries);
+        case State::ZipDescriptor: return zipDescriptor(entries);
+        case State::Skip: return skip();
+        }
+        return false;
+    }
+
+    bool detect() {
+        if (available() < 4) return false;
+        if (le32(head()) == kZipLocalHeader) {
+            state_ = State::ZipHeader;
+            return true;
+        }
+        if (available() < kTarBlock) return false;
+        if (!tarChecksumValid(head())) return fail("Unrecognized archive format, expected tar or zip");
+        state_ = State::TarHeader;
+        return true;
+    }
+
+    bool skip() {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(available(), skip_remaining_));
+        offset_ += count;
+        skip_remaining_ -= count;
+        if (skip_remaining_ == 0) state_ = skip_next_;
+        return count > 0 || skip_remaining_ == 0;
+    }
+
+    void skipThen(uint64_t bytes, State next) {
+        skip_remaining_ = bytes;
+        skip_next_ = next;
+        state_ = State::Skip;
+    }
+
+    // TAR --------------------------------------------------------------------
+    static bool tarChecksumValid(const unsigned char* header) {
+        uint64_t stored = 0;
+        if (!parseOctal(header + 148, 8, stored)) return false;
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kTarBlock; ++i) sum += (i >= 148 && i < 156) ? ' ' : header[i];
+        return sum == stored;
+    }
+
+    static bool parseOctal(const unsigned char* field, size_t length, uint64_t& value) {
+        value = 0;
+        size_t i = 0;
+        while (i < length && field[i] == ' ') ++i;
+        bool digits = false;
+        for (; i < length && field[i] >= '0' && field[i] <= '7'; ++i) {
+            value = value * 8 + (field[i] - '0');
+            digits = true;
+        }
+        return digits;
+    }
+
+    // Sizes of 8 GiB and up use the GNU base-256 form.
+    static bool tarSize(const unsigned char* field, uint64_t& size) {
+        if (!(field[0] & 0x80)) return parseOctal(field, 12, size);
+        size = field[0] & 0x7f;
+        for (size_t i = 1; i < 12; ++i) {
+            if (size >> 56) return false;
+            size = (size << 8) | field[i];
+        }
+        return true;
+    }
+
+    static std::string tarField(const unsigned char* field, size_t length) {
+        const char* text = reinterpret_cast<const char*>(field);
+        return std::string(text, std::find(text, text + length, '\0'));
+    }
+
+    bool tarHeader(std::vector<Entry>& entries) {
+        if (available() < kTarBlock) return false;
+        const unsigned char* header = head();
+        if (std::all_of(header, header + kTarBlock, [](unsigned char byte) { return byte == 0; })) {
+            offset_ += kTarBlock;
+            if (++zero_blocks_ == 2) finished_ = true;
+            return true;
+        }
+        zero_blocks_ = 0;
+        if (!tarChecksumValid(header)) return fail("Corrupt tar header");
+
+        uint64_t size = 0;
+        if (!tarSize(header + 124, size)) return fail("Corrupt tar entry size");
+        entry_type_ = static_cast<char>(header[156]);
+        entry_size_ = size;
+        uint64_t padded = (size + kTarBlock - 1) / kTarBlock * kTarBlock;
+
+        std::string name = tarField(header, 100);
+        if (std::memcmp(header + 257, "ustar", 5) == 0) {
+            std::string prefix = tarField(header + 345, 155);
+            if (!prefix.empty()) name = prefix + "/" + name;
+        }
+        offset_ += kTarBlock;
+
+        bool metadata = entry_type_ == 'L' || entry_type_ == 'x' || entry_type_ == 'g';
+        if (!metadata) {
+            entry_name_ = long_name_.empty() ? name : long_name_;
+            long_name_.clear();
+        }
+        bool regular = entry_type_ == '0' || entry_type_ == '\0' || entry_type_ == '7';
+        uint64_t limit = metadata ? kMaxMetadataBytes : max_entry_bytes_;
+        if (!(metadata || regular) || size > limit) {
+            if (regular) {
+                entries.push_back({entry_name_, "", "Entry exceeds " + std::to_string(limit) + " bytes"});
+            }
+            skipThen(padded, State::TarHeader);
+            return true;
+        }
+        entry_padded_ = padded;
+        state_ = State::TarData;
+        return true;
+    }
+
+    bool tarData(std::vector<Entry>& entries) {
+        if (available() < entry_padded_) return false;
+        std::string data(buffer_.data() + offset_, static_cast<size_t>(entry_size_));
+        offset_ += static_cast<size_t>(entry_padded_);
+        state_ = State::TarHeader;
+
+        if (entry_type_ == 'L') {
+            long_name_ = data.substr(0, data.find('\0'));
+        } else if (entry_type_ == 'x') {
+            long_name_ = paxPath(data);
+        } else if (entry_type_ != 'g') {
+            entries.push_back({entry_name_, std::move(data), ""});
+        }
+        return true;
+    }
+
+    // pax records are "<length> <key>=<value>\n".
+    static std::string paxPath(const std::string& records) {
+        size_t position = 0;
+        while (position < records.size()) {
+            size_t space = records.find(' ', position);
+            if (space == std::string::npos) break;
+            size_t length = std::strtoul(records.c_str() + position, nullptr, 10);
+            if (length == 0 || position + length > records.size()) break;
+            std::string record = records.substr(space + 1, position + length - space - 2);
+            if (record.compare(0, 5, "path=") == 0) return record.substr(5);
+            position += length;
+        }
+        return "";
+    }
+
+    // ZIP --------------------------------------------------------------------
+    bool zipHeader(std::vector<Entry>& entries) {
+        if (available() < 4) return false;
+        uint32_t signature = le32(head());
+        if (signature == kZipCentralHeader || signature == kZipEndRecord ||
+            signature == kZip64EndRecord) {
+            finished_ = true;
+            return true;
+        }
+        if (signature != kZipLocalHeader) return fail("Corrupt zip local header");
+        if (available() < 30) return false;
+
+        const unsigned char* header = head();
+        uint16_t flags = le16(header + 6);
+        uint16_t method = le16(header + 8);
+        entry_crc_ = le32(header + 14);
+        uint64_t compressed_size = le32(header + 18);
+        uint64_t size = le32(header + 22);
+        size_t name_length = le16(header + 26);
+        size_t extra_length = le16(header + 28);
+        if (available() < 30 + name_length + extra_length) return false;
+
+        entry_name_.assign(reinterpret_cast<const char*>(header) + 30, name_length);
+        entry_zip64_ = false;
+        const unsigned char* extra = header + 30 + name_length;
+        for (size_t i = 0; i + 4 <= extra_length;) {
+            uint16_t id = le16(extra + i);
+            uint16_t length = le16(extra + i + 2);
+            if (i + 4 + length > extra_length) break;
+            if (id == 0x0001) {
+                const unsigned char* field = extra + i + 4;
+                size_t used = 0;
+                if (size == 0xFFFFFFFFu && used + 8 <= length) { size = le64(field + used); used += 8; }
+                if (compressed_size == 0xFFFFFFFFu && used + 8 <= length) {
+                    compressed_size = le64(field + used);
+                }
+                entry_zip64_ = true;
+            }
+            i += 4 + length;
+        }
+        offset_ += 30 + name_length + extra_length;
+
+        entry_descriptor_ = (flags & 0x0008) != 0;
+        entry_size_ = compressed_size;
+        entry_oversize_ = false;
+        bool directory = !entry_name_.empty() && entry_name_.back() == '/';
+
+        if (entry_descriptor_ && (method != 8 || (flags & 0x0001))) {
+            return fail("Unsupported streamed zip entry: " + entry_name_);
+        }
+        // A stored entry is buffered whole, so its two sizes must agree.
+        if (method == 0 && !(flags & 0x0001) && compressed_size != size) {
+            return fail("Corrupt stored zip entry: " + entry_name_);
+        }
+        std::string problem;
+        if (flags & 0x0001) problem = "Encrypted entries are not supported";
+        else if (method != 0 && method != 8) problem = "Unsupported compression method " + std::to_string(method);
+        else if (!entry_descriptor_ && (size > max_entry_bytes_ || compressed_size > max_entry_bytes_)) {
+            problem = "Entry exceeds " + std::to_string(max_entry_bytes_) + " bytes";
+        }
+        if (directory || !problem.empty()) {
+            if (!directory) entries.push_back({entry_name_, "", problem});
+            skipThen(compressed_size, State::ZipHeader);
+            return true;
+        }
+
+        if (method == 0) {
+            state_ = State::ZipStored;
+            return true;
+        }
+        std::memset(&inflater_, 0, sizeof(inflater_));
+        if (inflateInit2(&inflater_, -MAX_WBITS) != Z_OK) return fail("Cannot initialize zlib");
+        inflating_ = true;
+        inflated_.clear();
+        state_ = State::ZipInflate;
+        return true;
+    }
+
+    bool zipStored(std::vector<Entry>& entries) {
+        if (available() < entry_size_) return false;
+        inflated_.assign(buffer_.data() + offset_, static_cast<size_t>(entry_size_));
+        offset_ += static_cast<size_t>(entry_size_);
+        emitZipEntry(entries, entry_crc_);
+        state_ = State::ZipHeader;
+        return true;
+    }
+
+    bool zipInflate(std::vector<Entry>& entries) {
+        size_t input = available();
+        if (!entry_descriptor_) input = static_cast<size_t>(std::min<uint64_t>(input, entry_size_));
+        if (input == 0) {
+            if (!entry_descriptor_ && entry_size_ == 0) return fail("Truncated deflate data in " + entry_name_);
+            return false;
+        }
+
+        inflater_.next_in = const_cast<Bytef*>(head());
+        inflater_.avail_in = static_cast<uInt>(std::min<size_t>(input, 1u << 30));
+        int result = Z_OK;
+        do {
+            inflater_.next_out = window_.data();
+            inflater_.avail_out = static_cast<uInt>(window_.size());
+            result = inflate(&inflater_, Z_NO_FLUSH);
+            size_t produced = window_.size() - inflater_.avail_out;
+            // Oversized output is still inflated, to find the entry's end,
+            // but not kept.
+            if (!entry_oversize_ && inflated_.size() + produced > max_entry_bytes_) {
+                entry_oversize_ = true;
+                inflated_.clear();
+                inflated_.shrink_to_fit();
+            }
+            if (!entry_oversize_) inflated_.append(reinterpret_cast<const char*>(window_.data()), produced);
+        } while (result == Z_OK && (inflater_.avail_in > 0 || inflater_.avail_out == 0));
+
+        size_t consumed = input - inflater_.avail_in;
+        offset_ += consumed;
+        if (!entry_descriptor_) entry_size_ -= consumed;
+
+        if (result == Z_STREAM_END) {
+            endInflate();
+            if (entry_descriptor_) {
+                state_ = State::ZipDescriptor;
+            } else {
+                emitZipEntry(entries, entry_crc_);
+                skipThen(entry_size_, State::ZipHeader);
+            }
+            return true;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR) return fail("Corrupt deflate data in " + entry_name_);
+        return consumed > 0;
+    }
+
+    bool zipDescriptor(std::vector<Entry>& entries) {
+        if (available() < 4) return false;
+        size_t signature = le32(head()) == kZipDescriptor ? 4 : 0;
+        size_t length = signature + 4 + (entry_zip64_ ? 16 : 8);
+        if (available() < length) return false;
+        uint32_t crc = le32(head() + signature);
+        offset_ += length;
+        emitZipEntry(entries, crc);
+        state_ = State::ZipHeader;
+        return true;
+    }
+
+    void emitZipEntry(std::vector<Entry>& entries, uint32_t expected_crc) {
+        if (entry_oversize_) {
+            entries.push_back({entry_name_, "", "Entry exceeds " + std::to_string(max_entry_bytes_) + " bytes"});
+        } else if (crc32(0L, reinterpret_cast<const Bytef*>(inflated_.data()),
+                         static_cast<uInt>(inflated_.size())) != expected_crc) {
+            entries.push_back({entry_name_, "", "CRC mismatch"});
+        } else {
+            entries.push_back({entry_name_, std::move(inflated_), ""});
+        }
+        inflated_.clear();
+    }
+
+    void endInflate() {
+        if (inflating_) inflateEnd(&inflater_);
+        inflating_ = false;
+    }
+
+    size_t max_entry_bytes_;
+    std::string buffer_;
+    size_t offset_ = 0;
+    State state_ = State::Detect;
+    bool finished_ = false;
+    std::string error_;
+
+    State skip_next_ = State::Detect;
+    uint64_t skip_remaining_ = 0;
+
+    std::string entry_name_;
+    uint64_t entry_size_ = 0;  // tar: data size; zip: compressed bytes left
+    uint64_t entry_padded_ = 0;
+    char entry_type_ = 0;
+    std::string long_name_;
+    int zero_blocks_ = 0;
+
+    uint32_t entry_crc_ = 0;
+    bool entry_descriptor_ = false;
+    bool entry_zip64_ = false;
+    bool entry_oversize_ = false;
+    z_stream inflater_{};
+    bool inflating_ = false;
+    std::vector<unsigned char> window_;
+    std::string inflated_;
+};
+
+#endif
@@ -1,7 +1,12 @@
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -9,6 +14,8 @@
 
 #include <grpcpp/grpcpp.h>
 #include "ocr.grpc.pb.h"
+#include "consistent_hash_ring.h"
+#include "content_hash.h"
 
 // GUI IMPLEMENTATION --------------------------------------------------------
 #include <QApplication>
@@ -27,28 +34,43 @@
 #include <QPixmap>
 //----------------------------------------------------------------------------
 
+using ocr::JobResultRequest;
+using ocr::JobResultResponse;
 using ocr::OCRService;
 using ocr::ProcessImageRequest;
 using ocr::ProcessImageResponse;
 
 class ImageTextExtractor {
 public:
-    ImageTextExtractor(const std::string& server_endpoint)
-        : service_stub_(OCRService::NewStub(
-            grpc::CreateChannel(server_endpoint, grpc::InsecureChannelCredentials()))) {}
+    // With several endpoints every image is routed by content hash, so each
+    // server's result cache sees all duplicates of the images it owns.
+    ImageTextExtractor(const std::vector<std::string>& server_endpoints)
+        : routing_ring_(server_endpoints.size()),
+          in_flight_(new std::atomic<int>[server_endpoints.size()]) {
+        for (size_t i = 0; i < server_endpoints.size(); ++i) {
+            channels_.push_back(
+                grpc::CreateChannel(server_endpoints[i], grpc::InsecureChannelCredentials()));
+            service_stubs_.push_back(OCRService::NewStub(channels_.back()));
+            in_flight_[i] = 0;
+        }
+    }
 
 //INTERPROCESS COMMUNICATION ---------------------------------------------------
     ProcessImageResponse extractFromImage(const std::string& session_identifier,
                                          const std::string& job_group_id,
                                          const std::string& file_path,
                                          const std::vector<unsigned char>& image_data,
-                                         int max_wait_seconds = 120) {
+                                         int max_wait_seconds = 120,
+                                         const std::string& profile = "") {
         ProcessImageRequest extraction_request;
         extraction_request.set_client_id(session_identifier);
         extraction_request.set_batch_id(job_group_id);
         extraction_request.set_filename(file_path);
         extraction_request.set_image(image_data.data(), image_data.size());
         extraction_request.set_lang("eng");
+        extraction_request.set_profile(profile);
+        extraction_request.set_job_id(makeJobId(session_identifier, job_group_id,
+                                                file_path, image_data));
 
         ProcessImageResponse extraction_response;
         grpc::ClientContext client_context;
@@ -57,8 +79,23 @@ public:
                            std::chrono::seconds(max_wait_seconds);
         client_context.set_deadline(timeout_point);
 
-        grpc::Status operation_status = service_stub_->ProcessImage(
+        size_t node = pickNode(image_data);
+        // Only a request sent over a connected channel can have been
+        // journaled; a server that was never reached is not waited for.
+        bool connected = channels_[node]->WaitForConnected(
+            std::min(timeout_point, std::chrono::system_clock::now() + std::chrono::seconds(5)));
+        in_flight_[node]++;
+        grpc::Status operation_status = service_stubs_[node]->ProcessImage(
             &client_context, extraction_request, &extraction_response);
+        in_flight_[node]--;
+
+        // A server running with a write-ahead log finishes the job after a
+        // crash; wait for it to come back instead of resubmitting.
+        if (connected && operation_status.error_code() == grpc::StatusCode::UNAVAILABLE) {
+            if (awaitJobResult(node, extraction_request.job_id(), timeout_point, extraction_response)) {
+                return extraction_response;
+            }
+        }
         
         if (!operation_status.ok()) {
             extraction_response.set_ok(false);
@@ -69,9 +106,71 @@ public:
 //----------------------------------------------------------------------------
 
 private:
-    std::unique_ptr<OCRService::Stub> service_stub_;
+    static std::string makeJobId(const std::string& session_identifier,
+                                 const std::string& job_group_id,
+                                 const std::string& file_path,
+                                 const std::vector<unsigned char>& image_data) {
+        std::ostringstream job_id;
+        job_id << session_identifier << '/' << job_group_id << '/' << file_path << '/'
+               << std::hex << contentHash(image_data.data(), image_data.size());
+        return job_id.str();
+    }
+
+    // Gives up after kMaxUnavailablePolls polls in a row find the server
+    // down, even if the deadline is further away.
+    static constexpr int kMaxUnavailablePolls = 15;
+
+    bool awaitJobResult(size_t node, const std::string& job_id,
+                        std::chrono::system_clock::time_point deadline,
+                        ProcessImageResponse& result) {
+        int unavailable_polls = 0;
+        while (std::chrono::system_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+
+            JobResultRequest request;
+            request.set_job_id(job_id);
+            JobResultResponse response;
+            grpc::ClientContext context;
+            context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+            grpc::Status status = service_stubs_[node]->GetJobResult(&context, request, &response);
+
+            if (status.error_code() == grpc::StatusCode::UNAVAILABLE) {
+                if (++unavailable_polls >= kMaxUnavailablePolls) return false;
+                continue;
+            }
+            unavailable_polls = 0;
+            if (!status.ok() || response.state() == ocr::JOB_UNKNOWN) return false;
+            if (response.state() == ocr::JOB_DONE) {
+                result = response.result();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t pickNode(const std::vector<unsigned char>& image_data) const {
+        if (service_stubs_.size() == 1) return 0;
+        std::vector<int> loads(service_stubs_.size());
+        for (size_t i = 0; i < loads.size(); ++i) loads[i] = in_flight_[i].load();
+        return routing_ring_.pick(contentHash(image_data.data(), image_data.size()), loads);
+    }
+
+    std::vector<std::shared_ptr<grpc::Channel>> channels_;
+    std::vector<std::unique_ptr<OCRService::Stub>> service_stubs_;
+    ConsistentHashRing routing_ring_;
+    std::unique_ptr<std::atomic<int>[]> in_flight_;
 };
 
+static std::vector<std::string> splitEndpoints(const std::string& endpoint_list) {
+    std::vector<std::string> endpoints;
+    std::stringstream stream(endpoint_list);
+    std::string endpoint;
+    while (std::getline(stream, endpoint, ',')) {
+        if (!endpoint.empty()) endpoints.push_back(endpoint);
+    }
+    return endpoints;
+}
+
 static bool loadImageData(const std::string& file_location, 
                          std::vector<unsigned char>& data_buffer) {
     std::ifstream input_file(file_location, std::ios::binary);
@@ -101,9 +200,10 @@ QString filterLettersOnly(const QString& input) {
 class TextExtractionUI : public QMainWindow {
     Q_OBJECT
 public:
-    TextExtractionUI(const std::string& server_endpoint, QWidget* parent = nullptr)
-        : QMainWindow(parent), extractor_(server_endpoint), 
-          client_session_id_("session_1"), job_sequence_(0),
+    TextExtractionUI(const std::vector<std::string>& server_endpoints, const std::string& profile,
+                     QWidget* parent = nullptr)
+        : QMainWindow(parent), extractor_(server_endpoints), 
+          client_session_id_(makeSessionId()), profile_(profile), job_sequence_(0),
           total_tasks_(0), completed_tasks_(0) {
         
         QWidget* main_container = new QWidget(this);
@@ -219,7 +319,8 @@ private slots:
                 }
 
                 ProcessImageResponse extraction_result =
-                    extractor_.extractFromImage(client_session_id_, current_batch_id, full_path, image_content, 120);
+                    extractor_.extractFromImage(client_session_id_, current_batch_id, full_path, image_content,
+                                               120, profile_);
 
                 QMetaObject::invokeMethod(this, [this, current_row, extraction_result]() {
                     if (extraction_result.ok()) {
@@ -278,8 +379,17 @@ private:
     }
 
 private:
+    // Job ids start with the session id, and a server with --wal-dir serves
+    // a stored result for any job id it has seen, so every run needs its own.
+    static std::string makeSessionId() {
+        std::ostringstream session;
+        session << "session_" << std::hex << std::mt19937_64(std::random_device{}())();
+        return session.str();
+    }
+
     ImageTextExtractor extractor_;
     std::string client_session_id_;
+    std::string profile_;
     int job_sequence_;
     int total_tasks_;
     std::atomic<int> completed_tasks_;
@@ -296,8 +406,14 @@ int main(int argc, char** argv) {
     
     std::string server_endpoint = "192.168.1.146:50051";
     if (argc >= 2) server_endpoint = argv[1];
+
+    std::string profile;
+    if (argc >= 3) profile = argv[2];
     
-    TextExtractionUI main_interface(server_endpoint);
+    std::vector<std::string> server_endpoints = splitEndpoints(server_endpoint);
+    if (server_endpoints.empty()) server_endpoints.push_back("192.168.1.146:50051");
+
+    TextExtractionUI main_interface(server_endpoints, profile);
     main_interface.show();
     
     return extraction_app.exec();
@@ -0,0 +1,53 @@
+#ifndef CONSISTENT_HASH_RING_H
+#define CONSISTENT_HASH_RING_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "content_hash.h"
+
+// Consistent hashing with bounded loads: an image goes to the first node
+// clockwise from its content hash whose in-flight count is below
+// ceil(load_factor * average), so duplicates keep hitting the node that has
+// them cached without letting one hot image overload it.
+class ConsistentHashRing {
+public:
+    ConsistentHashRing(size_t node_count, double load_factor = 1.25,
+                       int virtual_nodes_per_node = 100)
+        : node_count_(node_count), load_factor_(load_factor) {
+        for (size_t node = 0; node < node_count; ++node) {
+            for (int replica = 0; replica < virtual_nodes_per_node; ++replica) {
+                std::string label = std::to_string(node) + "#" + std::to_string(replica);
+                ring_[contentHash(label)] = node;
+            }
+        }
+    }
+
+    size_t pick(uint64_t key, const std::vector<int>& in_flight) const {
+        if (node_count_ <= 1) return 0;
+
+        long total = 0;
+        for (int load : in_flight) total += load;
+        int capacity = static_cast<int>(std::ceil(load_factor_ * (total + 1) / node_count_));
+
+        auto start = ring_.lower_bound(key);
+        if (start == ring_.end()) start = ring_.begin();
+        auto it = start;
+        for (size_t step = 0; step < ring_.size(); ++step, ++it) {
+            if (it == ring_.end()) it = ring_.begin();
+            if (in_flight[it->second] < capacity) return it->second;
+        }
+        return start->second;
+    }
+
+private:
+    size_t node_count_;
+    double load_factor_;
+    std::map<uint64_t, size_t> ring_;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 64-bit FNV-1a. Shared by the server (result cache keys) and the client
+// (consistent-hash routing) so both place identical images identically.
+inline uint64_t contentHash(const void* data, size_t size,
+                            uint64_t seed = 1469598103934665603ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline uint64_t contentHash(const std::string& text) {
+    return contentHash(text.data(), text.size());
+}
+
+#endif
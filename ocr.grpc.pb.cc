@@ -1,88 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: ocr.proto
-
-#include "ocr.pb.h"
-#include "ocr.grpc.pb.h"
-
-#include <functional>
-#include <grpcpp/support/async_stream.h>
-#include <grpcpp/support/async_unary_call.h>
-#include <grpcpp/impl/channel_interface.h>
-#include <grpcpp/impl/client_unary_call.h>
-#include <grpcpp/support/client_callback.h>
-#include <grpcpp/support/message_allocator.h>
-#include <grpcpp/support/method_handler.h>
-#include <grpcpp/impl/rpc_service_method.h>
-#include <grpcpp/support/server_callback.h>
-#include <grpcpp/impl/server_callback_handlers.h>
-#include <grpcpp/server_context.h>
-#include <grpcpp/impl/service_type.h>
-#include <grpcpp/support/sync_stream.h>
-#include <grpcpp/ports_def.inc>
-namespace ocr {
-
-static const char* OCRService_method_names[] = {
-  "/ocr.OCRService/ProcessImage",
-};
-
-std::unique_ptr< OCRService::Stub> OCRService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
-  (void)options;
-  std::unique_ptr< OCRService::Stub> stub(new OCRService::Stub(channel, options));
-  return stub;
-}
-
-OCRService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options)
-  : channel_(channel), rpcmethod_ProcessImage_(OCRService_method_names[0], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
-  {}
-
-::grpc::Status OCRService::Stub::ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::ocr::ProcessImageResponse* response) {
-  return ::grpc::internal::BlockingUnaryCall< ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), rpcmethod_ProcessImage_, context, request, response);
-}
-
-void OCRService::Stub::async::ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, std::function<void(::grpc::Status)> f) {
-  ::grpc::internal::CallbackUnaryCall< ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_ProcessImage_, context, request, response, std::move(f));
-}
-
-void OCRService::Stub::async::ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, ::grpc::ClientUnaryReactor* reactor) {
-  ::grpc::internal::ClientCallbackUnaryFactory::Create< ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_ProcessImage_, context, request, response, reactor);
-}
-
-::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>* OCRService::Stub::PrepareAsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc::internal::ClientAsyncResponseReaderHelper::Create< ::ocr::ProcessImageResponse, ::ocr::ProcessImageRequest, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), cq, rpcmethod_ProcessImage_, context, request);
-}
-
-::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>* OCRService::Stub::AsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-  auto* result =
-    this->PrepareAsyncProcessImageRaw(context, request, cq);
-  result->StartCall();
-  return result;
-}
-
-OCRService::Service::Service() {
-  AddMethod(new ::grpc::internal::RpcServiceMethod(
-      OCRService_method_names[0],
-      ::grpc::internal::RpcMethod::NORMAL_RPC,
-      new ::grpc::internal::RpcMethodHandler< OCRService::Service, ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(
-          [](OCRService::Service* service,
-             ::grpc::ServerContext* ctx,
-             const ::ocr::ProcessImageRequest* req,
-             ::ocr::ProcessImageResponse* resp) {
-               return service->ProcessImage(ctx, req, resp);
-             }, this)));
-}
-
-OCRService::Service::~Service() {
-}
-
-::grpc::Status OCRService::Service::ProcessImage(::grpc::ServerContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response) {
-  (void) context;
-  (void) request;
-  (void) response;
-  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-}
-
-
-}  // namespace ocr
-#include <grpcpp/ports_undef.inc>
-
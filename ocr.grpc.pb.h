@@ -1,246 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: ocr.proto
-#ifndef GRPC_ocr_2eproto__INCLUDED
-#define GRPC_ocr_2eproto__INCLUDED
-
-#include "ocr.pb.h"
-
-#include <functional>
-#include <grpcpp/generic/async_generic_service.h>
-#include <grpcpp/support/async_stream.h>
-#include <grpcpp/support/async_unary_call.h>
-#include <grpcpp/support/client_callback.h>
-#include <grpcpp/client_context.h>
-#include <grpcpp/completion_queue.h>
-#include <grpcpp/support/message_allocator.h>
-#include <grpcpp/support/method_handler.h>
-#include <grpcpp/impl/proto_utils.h>
-#include <grpcpp/impl/rpc_method.h>
-#include <grpcpp/support/server_callback.h>
-#include <grpcpp/impl/server_callback_handlers.h>
-#include <grpcpp/server_context.h>
-#include <grpcpp/impl/service_type.h>
-#include <grpcpp/support/status.h>
-#include <grpcpp/support/stub_options.h>
-#include <grpcpp/support/sync_stream.h>
-#include <grpcpp/ports_def.inc>
-
-namespace ocr {
-
-// Service for sending images to the server for OCR processing.
-class OCRService final {
- public:
-  static constexpr char const* service_full_name() {
-    return "ocr.OCRService";
-  }
-  class StubInterface {
-   public:
-    virtual ~StubInterface() {}
-    // Sends a single image for text extraction and returns the recognized text.
-    virtual ::grpc::Status ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::ocr::ProcessImageResponse* response) = 0;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>> AsyncProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>>(AsyncProcessImageRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>> PrepareAsyncProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>>(PrepareAsyncProcessImageRaw(context, request, cq));
-    }
-    class async_interface {
-     public:
-      virtual ~async_interface() {}
-      // Sends a single image for text extraction and returns the recognized text.
-      virtual void ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, std::function<void(::grpc::Status)>) = 0;
-      virtual void ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-    };
-    typedef class async_interface experimental_async_interface;
-    virtual class async_interface* async() { return nullptr; }
-    class async_interface* experimental_async() { return async(); }
-   private:
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>* AsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) = 0;
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::ocr::ProcessImageResponse>* PrepareAsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) = 0;
-  };
-  class Stub final : public StubInterface {
-   public:
-    Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-    ::grpc::Status ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::ocr::ProcessImageResponse* response) override;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>> AsyncProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>>(AsyncProcessImageRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>> PrepareAsyncProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>>(PrepareAsyncProcessImageRaw(context, request, cq));
-    }
-    class async final :
-      public StubInterface::async_interface {
-     public:
-      void ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, std::function<void(::grpc::Status)>) override;
-      void ProcessImage(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
-     private:
-      friend class Stub;
-      explicit async(Stub* stub): stub_(stub) { }
-      Stub* stub() { return stub_; }
-      Stub* stub_;
-    };
-    class async* async() override { return &async_stub_; }
-
-   private:
-    std::shared_ptr< ::grpc::ChannelInterface> channel_;
-    class async async_stub_{this};
-    ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>* AsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) override;
-    ::grpc::ClientAsyncResponseReader< ::ocr::ProcessImageResponse>* PrepareAsyncProcessImageRaw(::grpc::ClientContext* context, const ::ocr::ProcessImageRequest& request, ::grpc::CompletionQueue* cq) override;
-    const ::grpc::internal::RpcMethod rpcmethod_ProcessImage_;
-  };
-  static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-
-  class Service : public ::grpc::Service {
-   public:
-    Service();
-    virtual ~Service();
-    // Sends a single image for text extraction and returns the recognized text.
-    virtual ::grpc::Status ProcessImage(::grpc::ServerContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response);
-  };
-  template <class BaseClass>
-  class WithAsyncMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithAsyncMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodAsync(0);
-    }
-    ~WithAsyncMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestProcessImage(::grpc::ServerContext* context, ::ocr::ProcessImageRequest* request, ::grpc::ServerAsyncResponseWriter< ::ocr::ProcessImageResponse>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  typedef WithAsyncMethod_ProcessImage<Service > AsyncService;
-  template <class BaseClass>
-  class WithCallbackMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithCallbackMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodCallback(0,
-          new ::grpc::internal::CallbackUnaryHandler< ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse>(
-            [this](
-                   ::grpc::CallbackServerContext* context, const ::ocr::ProcessImageRequest* request, ::ocr::ProcessImageResponse* response) { return this->ProcessImage(context, request, response); }));}
-    void SetMessageAllocatorFor_ProcessImage(
-        ::grpc::MessageAllocator< ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse>* allocator) {
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(0);
-      static_cast<::grpc::internal::CallbackUnaryHandler< ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse>*>(handler)
-              ->SetMessageAllocator(allocator);
-    }
-    ~WithCallbackMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    virtual ::grpc::ServerUnaryReactor* ProcessImage(
-      ::grpc::CallbackServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/)  { return nullptr; }
-  };
-  typedef WithCallbackMethod_ProcessImage<Service > CallbackService;
-  typedef CallbackService ExperimentalCallbackService;
-  template <class BaseClass>
-  class WithGenericMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithGenericMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodGeneric(0);
-    }
-    ~WithGenericMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-  };
-  template <class BaseClass>
-  class WithRawMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodRaw(0);
-    }
-    ~WithRawMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestProcessImage(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  template <class BaseClass>
-  class WithRawCallbackMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawCallbackMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodRawCallback(0,
-          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
-            [this](
-                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->ProcessImage(context, request, response); }));
-    }
-    ~WithRawCallbackMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    virtual ::grpc::ServerUnaryReactor* ProcessImage(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
-  };
-  template <class BaseClass>
-  class WithStreamedUnaryMethod_ProcessImage : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithStreamedUnaryMethod_ProcessImage() {
-      ::grpc::Service::MarkMethodStreamed(0,
-        new ::grpc::internal::StreamedUnaryHandler<
-          ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse>(
-            [this](::grpc::ServerContext* context,
-                   ::grpc::ServerUnaryStreamer<
-                     ::ocr::ProcessImageRequest, ::ocr::ProcessImageResponse>* streamer) {
-                       return this->StreamedProcessImage(context,
-                         streamer);
-                  }));
-    }
-    ~WithStreamedUnaryMethod_ProcessImage() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable regular version of this method
-    ::grpc::Status ProcessImage(::grpc::ServerContext* /*context*/, const ::ocr::ProcessImageRequest* /*request*/, ::ocr::ProcessImageResponse* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    // replace default version of method with streamed unary
-    virtual ::grpc::Status StreamedProcessImage(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::ocr::ProcessImageRequest,::ocr::ProcessImageResponse>* server_unary_streamer) = 0;
-  };
-  typedef WithStreamedUnaryMethod_ProcessImage<Service > StreamedUnaryService;
-  typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_ProcessImage<Service > StreamedService;
-};
-
-}  // namespace ocr
-
-
-#include <grpcpp/ports_undef.inc>
-#endif  // GRPC_ocr_2eproto__INCLUDED
@@ -1,1112 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// NO CHECKED-IN PROTOBUF GENCODE
-// source: ocr.proto
-// Protobuf C++ Version: 6.33.1
-
-#ifndef ocr_2eproto_2epb_2eh
-#define ocr_2eproto_2epb_2eh
-
-#include <limits>
-#include <string>
-#include <type_traits>
-#include <utility>
-
-#include "google/protobuf/runtime_version.h"
-#if PROTOBUF_VERSION != 6033001
-#error "Protobuf C++ gencode is built with an incompatible version of"
-#error "Protobuf C++ headers/runtime. See"
-#error "https://protobuf.dev/support/cross-version-runtime-guarantee/#cpp"
-#endif
-#include "google/protobuf/io/coded_stream.h"
-#include "google/protobuf/arena.h"
-#include "google/protobuf/arenastring.h"
-#include "google/protobuf/generated_message_tctable_decl.h"
-#include "google/protobuf/generated_message_util.h"
-#include "google/protobuf/metadata_lite.h"
-#include "google/protobuf/generated_message_reflection.h"
-#include "google/protobuf/message.h"
-#include "google/protobuf/message_lite.h"
-#include "google/protobuf/repeated_field.h"  // IWYU pragma: export
-#include "google/protobuf/extension_set.h"  // IWYU pragma: export
-#include "google/protobuf/unknown_field_set.h"
-// @@protoc_insertion_point(includes)
-
-// Must be included last.
-#include "google/protobuf/port_def.inc"
-
-#define PROTOBUF_INTERNAL_EXPORT_ocr_2eproto
-
-namespace google {
-namespace protobuf {
-namespace internal {
-template <typename T>
-::absl::string_view GetAnyMessageName();
-}  // namespace internal
-}  // namespace protobuf
-}  // namespace google
-
-// Internal implementation detail -- do not use these members.
-struct TableStruct_ocr_2eproto {
-  static const ::uint32_t offsets[];
-};
-extern "C" {
-extern const ::google::protobuf::internal::DescriptorTable descriptor_table_ocr_2eproto;
-}  // extern "C"
-namespace ocr {
-class ProcessImageRequest;
-struct ProcessImageRequestDefaultTypeInternal;
-extern ProcessImageRequestDefaultTypeInternal _ProcessImageRequest_default_instance_;
-extern const ::google::protobuf::internal::ClassDataFull ProcessImageRequest_class_data_;
-class ProcessImageResponse;
-struct ProcessImageResponseDefaultTypeInternal;
-extern ProcessImageResponseDefaultTypeInternal _ProcessImageResponse_default_instance_;
-extern const ::google::protobuf::internal::ClassDataFull ProcessImageResponse_class_data_;
-}  // namespace ocr
-namespace google {
-namespace protobuf {
-}  // namespace protobuf
-}  // namespace google
-
-namespace ocr {
-
-// ===================================================================
-
-
-// -------------------------------------------------------------------
-
-class ProcessImageResponse final : public ::google::protobuf::Message
-/* @@protoc_insertion_point(class_definition:ocr.ProcessImageResponse) */ {
- public:
-  inline ProcessImageResponse() : ProcessImageResponse(nullptr) {}
-  ~ProcessImageResponse() PROTOBUF_FINAL;
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-  void operator delete(ProcessImageResponse* PROTOBUF_NONNULL msg, ::std::destroying_delete_t) {
-    SharedDtor(*msg);
-    ::google::protobuf::internal::SizedDelete(msg, sizeof(ProcessImageResponse));
-  }
-#endif
-
-  template <typename = void>
-  explicit PROTOBUF_CONSTEXPR ProcessImageResponse(::google::protobuf::internal::ConstantInitialized);
-
-  inline ProcessImageResponse(const ProcessImageResponse& from) : ProcessImageResponse(nullptr, from) {}
-  inline ProcessImageResponse(ProcessImageResponse&& from) noexcept
-      : ProcessImageResponse(nullptr, ::std::move(from)) {}
-  inline ProcessImageResponse& operator=(const ProcessImageResponse& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline ProcessImageResponse& operator=(ProcessImageResponse&& from) noexcept {
-    if (this == &from) return *this;
-    if (::google::protobuf::internal::CanMoveWithInternalSwap(GetArena(), from.GetArena())) {
-      InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
-      ABSL_ATTRIBUTE_LIFETIME_BOUND {
-    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
-  }
-  inline ::google::protobuf::UnknownFieldSet* PROTOBUF_NONNULL mutable_unknown_fields()
-      ABSL_ATTRIBUTE_LIFETIME_BOUND {
-    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
-  }
-
-  static const ::google::protobuf::Descriptor* PROTOBUF_NONNULL descriptor() {
-    return GetDescriptor();
-  }
-  static const ::google::protobuf::Descriptor* PROTOBUF_NONNULL GetDescriptor() {
-    return default_instance().GetMetadata().descriptor;
-  }
-  static const ::google::protobuf::Reflection* PROTOBUF_NONNULL GetReflection() {
-    return default_instance().GetMetadata().reflection;
-  }
-  static const ProcessImageResponse& default_instance() {
-    return *reinterpret_cast<const ProcessImageResponse*>(
-        &_ProcessImageResponse_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages = 1;
-  friend void swap(ProcessImageResponse& a, ProcessImageResponse& b) { a.Swap(&b); }
-  inline void Swap(ProcessImageResponse* PROTOBUF_NONNULL other) {
-    if (other == this) return;
-    if (::google::protobuf::internal::CanUseInternalSwap(GetArena(), other->GetArena())) {
-      InternalSwap(other);
-    } else {
-      ::google::protobuf::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(ProcessImageResponse* PROTOBUF_NONNULL other) {
-    if (other == this) return;
-    ABSL_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  ProcessImageResponse* PROTOBUF_NONNULL New(::google::protobuf::Arena* PROTOBUF_NULLABLE arena = nullptr) const {
-    return ::google::protobuf::Message::DefaultConstruct<ProcessImageResponse>(arena);
-  }
-  using ::google::protobuf::Message::CopyFrom;
-  void CopyFrom(const ProcessImageResponse& from);
-  using ::google::protobuf::Message::MergeFrom;
-  void MergeFrom(const ProcessImageResponse& from) { ProcessImageResponse::MergeImpl(*this, from); }
-
-  private:
-  static void MergeImpl(::google::protobuf::MessageLite& to_msg,
-                        const ::google::protobuf::MessageLite& from_msg);
-
-  public:
-  bool IsInitialized() const {
-    return true;
-  }
-  ABSL_ATTRIBUTE_REINITIALIZES void Clear() PROTOBUF_FINAL;
-  #if defined(PROTOBUF_CUSTOM_VTABLE)
-  private:
-  static ::size_t ByteSizeLong(const ::google::protobuf::MessageLite& msg);
-  static ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      const ::google::protobuf::MessageLite& msg, ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream);
-
-  public:
-  ::size_t ByteSizeLong() const { return ByteSizeLong(*this); }
-  ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream) const {
-    return _InternalSerialize(*this, target, stream);
-  }
-  #else   // PROTOBUF_CUSTOM_VTABLE
-  ::size_t ByteSizeLong() const final;
-  ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream) const final;
-  #endif  // PROTOBUF_CUSTOM_VTABLE
-  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
-
-  private:
-  void SharedCtor(::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  static void SharedDtor(MessageLite& self);
-  void InternalSwap(ProcessImageResponse* PROTOBUF_NONNULL other);
- private:
-  template <typename T>
-  friend ::absl::string_view(::google::protobuf::internal::GetAnyMessageName)();
-  static ::absl::string_view FullMessageName() { return "ocr.ProcessImageResponse"; }
-
-  explicit ProcessImageResponse(::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  ProcessImageResponse(::google::protobuf::Arena* PROTOBUF_NULLABLE arena, const ProcessImageResponse& from);
-  ProcessImageResponse(
-      ::google::protobuf::Arena* PROTOBUF_NULLABLE arena, ProcessImageResponse&& from) noexcept
-      : ProcessImageResponse(arena) {
-    *this = ::std::move(from);
-  }
-  const ::google::protobuf::internal::ClassData* PROTOBUF_NONNULL GetClassData() const PROTOBUF_FINAL;
-  static void* PROTOBUF_NONNULL PlacementNew_(
-      const void* PROTOBUF_NONNULL, void* PROTOBUF_NONNULL mem,
-      ::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  static constexpr auto InternalNewImpl_();
-
- public:
-  static constexpr auto InternalGenerateClassData_();
-
-  ::google::protobuf::Metadata GetMetadata() const;
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-  enum : int {
-    kTextFieldNumber = 2,
-    kMessageFieldNumber = 3,
-    kProcessingTimeMsFieldNumber = 4,
-    kOkFieldNumber = 1,
-  };
-  // string text = 2;
-  void clear_text() ;
-  const ::std::string& text() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_text(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_text();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_text();
-  void set_allocated_text(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_text() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_text(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_text();
-
-  public:
-  // string message = 3;
-  void clear_message() ;
-  const ::std::string& message() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_message(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_message();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_message();
-  void set_allocated_message(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_message() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_message(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_message();
-
-  public:
-  // int64 processing_time_ms = 4;
-  void clear_processing_time_ms() ;
-  ::int64_t processing_time_ms() const;
-  void set_processing_time_ms(::int64_t value);
-
-  private:
-  ::int64_t _internal_processing_time_ms() const;
-  void _internal_set_processing_time_ms(::int64_t value);
-
-  public:
-  // bool ok = 1;
-  void clear_ok() ;
-  bool ok() const;
-  void set_ok(bool value);
-
-  private:
-  bool _internal_ok() const;
-  void _internal_set_ok(bool value);
-
-  public:
-  // @@protoc_insertion_point(class_scope:ocr.ProcessImageResponse)
- private:
-  class _Internal;
-  friend class ::google::protobuf::internal::TcParser;
-  static const ::google::protobuf::internal::TcParseTable<2, 4,
-                                   0, 44,
-                                   2>
-      _table_;
-
-  friend class ::google::protobuf::MessageLite;
-  friend class ::google::protobuf::Arena;
-  template <typename T>
-  friend class ::google::protobuf::Arena::InternalHelper;
-  using InternalArenaConstructable_ = void;
-  using DestructorSkippable_ = void;
-  struct Impl_ {
-    inline explicit constexpr Impl_(::google::protobuf::internal::ConstantInitialized) noexcept;
-    inline explicit Impl_(
-        ::google::protobuf::internal::InternalVisibility visibility,
-        ::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-    inline explicit Impl_(
-        ::google::protobuf::internal::InternalVisibility visibility,
-        ::google::protobuf::Arena* PROTOBUF_NULLABLE arena, const Impl_& from,
-        const ProcessImageResponse& from_msg);
-    ::google::protobuf::internal::HasBits<1> _has_bits_;
-    ::google::protobuf::internal::CachedSize _cached_size_;
-    ::google::protobuf::internal::ArenaStringPtr text_;
-    ::google::protobuf::internal::ArenaStringPtr message_;
-    ::int64_t processing_time_ms_;
-    bool ok_;
-    PROTOBUF_TSAN_DECLARE_MEMBER
-  };
-  union { Impl_ _impl_; };
-  friend struct ::TableStruct_ocr_2eproto;
-};
-
-extern const ::google::protobuf::internal::ClassDataFull ProcessImageResponse_class_data_;
-// -------------------------------------------------------------------
-
-class ProcessImageRequest final : public ::google::protobuf::Message
-/* @@protoc_insertion_point(class_definition:ocr.ProcessImageRequest) */ {
- public:
-  inline ProcessImageRequest() : ProcessImageRequest(nullptr) {}
-  ~ProcessImageRequest() PROTOBUF_FINAL;
-
-#if defined(PROTOBUF_CUSTOM_VTABLE)
-  void operator delete(ProcessImageRequest* PROTOBUF_NONNULL msg, ::std::destroying_delete_t) {
-    SharedDtor(*msg);
-    ::google::protobuf::internal::SizedDelete(msg, sizeof(ProcessImageRequest));
-  }
-#endif
-
-  template <typename = void>
-  explicit PROTOBUF_CONSTEXPR ProcessImageRequest(::google::protobuf::internal::ConstantInitialized);
-
-  inline ProcessImageRequest(const ProcessImageRequest& from) : ProcessImageRequest(nullptr, from) {}
-  inline ProcessImageRequest(ProcessImageRequest&& from) noexcept
-      : ProcessImageRequest(nullptr, ::std::move(from)) {}
-  inline ProcessImageRequest& operator=(const ProcessImageRequest& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline ProcessImageRequest& operator=(ProcessImageRequest&& from) noexcept {
-    if (this == &from) return *this;
-    if (::google::protobuf::internal::CanMoveWithInternalSwap(GetArena(), from.GetArena())) {
-      InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
-      ABSL_ATTRIBUTE_LIFETIME_BOUND {
-    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
-  }
-  inline ::google::protobuf::UnknownFieldSet* PROTOBUF_NONNULL mutable_unknown_fields()
-      ABSL_ATTRIBUTE_LIFETIME_BOUND {
-    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
-  }
-
-  static const ::google::protobuf::Descriptor* PROTOBUF_NONNULL descriptor() {
-    return GetDescriptor();
-  }
-  static const ::google::protobuf::Descriptor* PROTOBUF_NONNULL GetDescriptor() {
-    return default_instance().GetMetadata().descriptor;
-  }
-  static const ::google::protobuf::Reflection* PROTOBUF_NONNULL GetReflection() {
-    return default_instance().GetMetadata().reflection;
-  }
-  static const ProcessImageRequest& default_instance() {
-    return *reinterpret_cast<const ProcessImageRequest*>(
-        &_ProcessImageRequest_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages = 0;
-  friend void swap(ProcessImageRequest& a, ProcessImageRequest& b) { a.Swap(&b); }
-  inline void Swap(ProcessImageRequest* PROTOBUF_NONNULL other) {
-    if (other == this) return;
-    if (::google::protobuf::internal::CanUseInternalSwap(GetArena(), other->GetArena())) {
-      InternalSwap(other);
-    } else {
-      ::google::protobuf::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(ProcessImageRequest* PROTOBUF_NONNULL other) {
-    if (other == this) return;
-    ABSL_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  ProcessImageRequest* PROTOBUF_NONNULL New(::google::protobuf::Arena* PROTOBUF_NULLABLE arena = nullptr) const {
-    return ::google::protobuf::Message::DefaultConstruct<ProcessImageRequest>(arena);
-  }
-  using ::google::protobuf::Message::CopyFrom;
-  void CopyFrom(const ProcessImageRequest& from);
-  using ::google::protobuf::Message::MergeFrom;
-  void MergeFrom(const ProcessImageRequest& from) { ProcessImageRequest::MergeImpl(*this, from); }
-
-  private:
-  static void MergeImpl(::google::protobuf::MessageLite& to_msg,
-                        const ::google::protobuf::MessageLite& from_msg);
-
-  public:
-  bool IsInitialized() const {
-    return true;
-  }
-  ABSL_ATTRIBUTE_REINITIALIZES void Clear() PROTOBUF_FINAL;
-  #if defined(PROTOBUF_CUSTOM_VTABLE)
-  private:
-  static ::size_t ByteSizeLong(const ::google::protobuf::MessageLite& msg);
-  static ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      const ::google::protobuf::MessageLite& msg, ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream);
-
-  public:
-  ::size_t ByteSizeLong() const { return ByteSizeLong(*this); }
-  ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream) const {
-    return _InternalSerialize(*this, target, stream);
-  }
-  #else   // PROTOBUF_CUSTOM_VTABLE
-  ::size_t ByteSizeLong() const final;
-  ::uint8_t* PROTOBUF_NONNULL _InternalSerialize(
-      ::uint8_t* PROTOBUF_NONNULL target,
-      ::google::protobuf::io::EpsCopyOutputStream* PROTOBUF_NONNULL stream) const final;
-  #endif  // PROTOBUF_CUSTOM_VTABLE
-  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
-
-  private:
-  void SharedCtor(::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  static void SharedDtor(MessageLite& self);
-  void InternalSwap(ProcessImageRequest* PROTOBUF_NONNULL other);
- private:
-  template <typename T>
-  friend ::absl::string_view(::google::protobuf::internal::GetAnyMessageName)();
-  static ::absl::string_view FullMessageName() { return "ocr.ProcessImageRequest"; }
-
-  explicit ProcessImageRequest(::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  ProcessImageRequest(::google::protobuf::Arena* PROTOBUF_NULLABLE arena, const ProcessImageRequest& from);
-  ProcessImageRequest(
-      ::google::protobuf::Arena* PROTOBUF_NULLABLE arena, ProcessImageRequest&& from) noexcept
-      : ProcessImageRequest(arena) {
-    *this = ::std::move(from);
-  }
-  const ::google::protobuf::internal::ClassData* PROTOBUF_NONNULL GetClassData() const PROTOBUF_FINAL;
-  static void* PROTOBUF_NONNULL PlacementNew_(
-      const void* PROTOBUF_NONNULL, void* PROTOBUF_NONNULL mem,
-      ::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-  static constexpr auto InternalNewImpl_();
-
- public:
-  static constexpr auto InternalGenerateClassData_();
-
-  ::google::protobuf::Metadata GetMetadata() const;
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-  enum : int {
-    kClientIdFieldNumber = 1,
-    kBatchIdFieldNumber = 2,
-    kFilenameFieldNumber = 3,
-    kImageFieldNumber = 4,
-    kLangFieldNumber = 5,
-  };
-  // string client_id = 1;
-  void clear_client_id() ;
-  const ::std::string& client_id() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_client_id(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_client_id();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_client_id();
-  void set_allocated_client_id(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_client_id() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_client_id(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_client_id();
-
-  public:
-  // string batch_id = 2;
-  void clear_batch_id() ;
-  const ::std::string& batch_id() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_batch_id(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_batch_id();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_batch_id();
-  void set_allocated_batch_id(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_batch_id() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_batch_id(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_batch_id();
-
-  public:
-  // string filename = 3;
-  void clear_filename() ;
-  const ::std::string& filename() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_filename(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_filename();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_filename();
-  void set_allocated_filename(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_filename() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_filename(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_filename();
-
-  public:
-  // bytes image = 4;
-  void clear_image() ;
-  const ::std::string& image() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_image(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_image();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_image();
-  void set_allocated_image(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_image() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_image(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_image();
-
-  public:
-  // string lang = 5;
-  void clear_lang() ;
-  const ::std::string& lang() const;
-  template <typename Arg_ = const ::std::string&, typename... Args_>
-  void set_lang(Arg_&& arg, Args_... args);
-  ::std::string* PROTOBUF_NONNULL mutable_lang();
-  [[nodiscard]] ::std::string* PROTOBUF_NULLABLE release_lang();
-  void set_allocated_lang(::std::string* PROTOBUF_NULLABLE value);
-
-  private:
-  const ::std::string& _internal_lang() const;
-  PROTOBUF_ALWAYS_INLINE void _internal_set_lang(const ::std::string& value);
-  ::std::string* PROTOBUF_NONNULL _internal_mutable_lang();
-
-  public:
-  // @@protoc_insertion_point(class_scope:ocr.ProcessImageRequest)
- private:
-  class _Internal;
-  friend class ::google::protobuf::internal::TcParser;
-  static const ::google::protobuf::internal::TcParseTable<3, 5,
-                                   0, 61,
-                                   2>
-      _table_;
-
-  friend class ::google::protobuf::MessageLite;
-  friend class ::google::protobuf::Arena;
-  template <typename T>
-  friend class ::google::protobuf::Arena::InternalHelper;
-  using InternalArenaConstructable_ = void;
-  using DestructorSkippable_ = void;
-  struct Impl_ {
-    inline explicit constexpr Impl_(::google::protobuf::internal::ConstantInitialized) noexcept;
-    inline explicit Impl_(
-        ::google::protobuf::internal::InternalVisibility visibility,
-        ::google::protobuf::Arena* PROTOBUF_NULLABLE arena);
-    inline explicit Impl_(
-        ::google::protobuf::internal::InternalVisibility visibility,
-        ::google::protobuf::Arena* PROTOBUF_NULLABLE arena, const Impl_& from,
-        const ProcessImageRequest& from_msg);
-    ::google::protobuf::internal::HasBits<1> _has_bits_;
-    ::google::protobuf::internal::CachedSize _cached_size_;
-    ::google::protobuf::internal::ArenaStringPtr client_id_;
-    ::google::protobuf::internal::ArenaStringPtr batch_id_;
-    ::google::protobuf::internal::ArenaStringPtr filename_;
-    ::google::protobuf::internal::ArenaStringPtr image_;
-    ::google::protobuf::internal::ArenaStringPtr lang_;
-    PROTOBUF_TSAN_DECLARE_MEMBER
-  };
-  union { Impl_ _impl_; };
-  friend struct ::TableStruct_ocr_2eproto;
-};
-
-extern const ::google::protobuf::internal::ClassDataFull ProcessImageRequest_class_data_;
-
-// ===================================================================
-
-
-
-
-// ===================================================================
-
-
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// -------------------------------------------------------------------
-
-// ProcessImageRequest
-
-// string client_id = 1;
-inline void ProcessImageRequest::clear_client_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.client_id_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000001U);
-}
-inline const ::std::string& ProcessImageRequest::client_id() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageRequest.client_id)
-  return _internal_client_id();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageRequest::set_client_id(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  _impl_.client_id_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageRequest.client_id)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::mutable_client_id()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  ::std::string* _s = _internal_mutable_client_id();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageRequest.client_id)
-  return _s;
-}
-inline const ::std::string& ProcessImageRequest::_internal_client_id() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.client_id_.Get();
-}
-inline void ProcessImageRequest::_internal_set_client_id(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.client_id_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::_internal_mutable_client_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.client_id_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageRequest::release_client_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageRequest.client_id)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000001U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000001U);
-  auto* released = _impl_.client_id_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.client_id_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageRequest::set_allocated_client_id(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000001U);
-  }
-  _impl_.client_id_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.client_id_.IsDefault()) {
-    _impl_.client_id_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageRequest.client_id)
-}
-
-// string batch_id = 2;
-inline void ProcessImageRequest::clear_batch_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.batch_id_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000002U);
-}
-inline const ::std::string& ProcessImageRequest::batch_id() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageRequest.batch_id)
-  return _internal_batch_id();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageRequest::set_batch_id(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  _impl_.batch_id_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageRequest.batch_id)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::mutable_batch_id()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  ::std::string* _s = _internal_mutable_batch_id();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageRequest.batch_id)
-  return _s;
-}
-inline const ::std::string& ProcessImageRequest::_internal_batch_id() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.batch_id_.Get();
-}
-inline void ProcessImageRequest::_internal_set_batch_id(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.batch_id_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::_internal_mutable_batch_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.batch_id_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageRequest::release_batch_id() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageRequest.batch_id)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000002U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000002U);
-  auto* released = _impl_.batch_id_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.batch_id_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageRequest::set_allocated_batch_id(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000002U);
-  }
-  _impl_.batch_id_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.batch_id_.IsDefault()) {
-    _impl_.batch_id_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageRequest.batch_id)
-}
-
-// string filename = 3;
-inline void ProcessImageRequest::clear_filename() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.filename_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000004U);
-}
-inline const ::std::string& ProcessImageRequest::filename() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageRequest.filename)
-  return _internal_filename();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageRequest::set_filename(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000004U);
-  _impl_.filename_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageRequest.filename)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::mutable_filename()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000004U);
-  ::std::string* _s = _internal_mutable_filename();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageRequest.filename)
-  return _s;
-}
-inline const ::std::string& ProcessImageRequest::_internal_filename() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.filename_.Get();
-}
-inline void ProcessImageRequest::_internal_set_filename(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.filename_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::_internal_mutable_filename() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.filename_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageRequest::release_filename() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageRequest.filename)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000004U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000004U);
-  auto* released = _impl_.filename_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.filename_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageRequest::set_allocated_filename(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000004U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000004U);
-  }
-  _impl_.filename_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.filename_.IsDefault()) {
-    _impl_.filename_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageRequest.filename)
-}
-
-// bytes image = 4;
-inline void ProcessImageRequest::clear_image() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.image_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000008U);
-}
-inline const ::std::string& ProcessImageRequest::image() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageRequest.image)
-  return _internal_image();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageRequest::set_image(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000008U);
-  _impl_.image_.SetBytes(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageRequest.image)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::mutable_image()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000008U);
-  ::std::string* _s = _internal_mutable_image();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageRequest.image)
-  return _s;
-}
-inline const ::std::string& ProcessImageRequest::_internal_image() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.image_.Get();
-}
-inline void ProcessImageRequest::_internal_set_image(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.image_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::_internal_mutable_image() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.image_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageRequest::release_image() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageRequest.image)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000008U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000008U);
-  auto* released = _impl_.image_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.image_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageRequest::set_allocated_image(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000008U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000008U);
-  }
-  _impl_.image_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.image_.IsDefault()) {
-    _impl_.image_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageRequest.image)
-}
-
-// string lang = 5;
-inline void ProcessImageRequest::clear_lang() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.lang_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000010U);
-}
-inline const ::std::string& ProcessImageRequest::lang() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageRequest.lang)
-  return _internal_lang();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageRequest::set_lang(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000010U);
-  _impl_.lang_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageRequest.lang)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::mutable_lang()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000010U);
-  ::std::string* _s = _internal_mutable_lang();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageRequest.lang)
-  return _s;
-}
-inline const ::std::string& ProcessImageRequest::_internal_lang() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.lang_.Get();
-}
-inline void ProcessImageRequest::_internal_set_lang(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.lang_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageRequest::_internal_mutable_lang() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.lang_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageRequest::release_lang() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageRequest.lang)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000010U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000010U);
-  auto* released = _impl_.lang_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.lang_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageRequest::set_allocated_lang(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000010U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000010U);
-  }
-  _impl_.lang_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.lang_.IsDefault()) {
-    _impl_.lang_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageRequest.lang)
-}
-
-// -------------------------------------------------------------------
-
-// ProcessImageResponse
-
-// bool ok = 1;
-inline void ProcessImageResponse::clear_ok() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.ok_ = false;
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000008U);
-}
-inline bool ProcessImageResponse::ok() const {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageResponse.ok)
-  return _internal_ok();
-}
-inline void ProcessImageResponse::set_ok(bool value) {
-  _internal_set_ok(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000008U);
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageResponse.ok)
-}
-inline bool ProcessImageResponse::_internal_ok() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.ok_;
-}
-inline void ProcessImageResponse::_internal_set_ok(bool value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.ok_ = value;
-}
-
-// string text = 2;
-inline void ProcessImageResponse::clear_text() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.text_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000001U);
-}
-inline const ::std::string& ProcessImageResponse::text() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageResponse.text)
-  return _internal_text();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageResponse::set_text(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  _impl_.text_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageResponse.text)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageResponse::mutable_text()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  ::std::string* _s = _internal_mutable_text();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageResponse.text)
-  return _s;
-}
-inline const ::std::string& ProcessImageResponse::_internal_text() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.text_.Get();
-}
-inline void ProcessImageResponse::_internal_set_text(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.text_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageResponse::_internal_mutable_text() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.text_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageResponse::release_text() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageResponse.text)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000001U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000001U);
-  auto* released = _impl_.text_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.text_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageResponse::set_allocated_text(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000001U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000001U);
-  }
-  _impl_.text_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.text_.IsDefault()) {
-    _impl_.text_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageResponse.text)
-}
-
-// string message = 3;
-inline void ProcessImageResponse::clear_message() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.ClearToEmpty();
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000002U);
-}
-inline const ::std::string& ProcessImageResponse::message() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageResponse.message)
-  return _internal_message();
-}
-template <typename Arg_, typename... Args_>
-PROTOBUF_ALWAYS_INLINE void ProcessImageResponse::set_message(Arg_&& arg, Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  _impl_.message_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageResponse.message)
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageResponse::mutable_message()
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  ::std::string* _s = _internal_mutable_message();
-  // @@protoc_insertion_point(field_mutable:ocr.ProcessImageResponse.message)
-  return _s;
-}
-inline const ::std::string& ProcessImageResponse::_internal_message() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.message_.Get();
-}
-inline void ProcessImageResponse::_internal_set_message(const ::std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.Set(value, GetArena());
-}
-inline ::std::string* PROTOBUF_NONNULL ProcessImageResponse::_internal_mutable_message() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.message_.Mutable( GetArena());
-}
-inline ::std::string* PROTOBUF_NULLABLE ProcessImageResponse::release_message() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:ocr.ProcessImageResponse.message)
-  if (!CheckHasBit(_impl_._has_bits_[0], 0x00000002U)) {
-    return nullptr;
-  }
-  ClearHasBit(_impl_._has_bits_[0], 0x00000002U);
-  auto* released = _impl_.message_.Release();
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString()) {
-    _impl_.message_.Set("", GetArena());
-  }
-  return released;
-}
-inline void ProcessImageResponse::set_allocated_message(::std::string* PROTOBUF_NULLABLE value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  if (value != nullptr) {
-    SetHasBit(_impl_._has_bits_[0], 0x00000002U);
-  } else {
-    ClearHasBit(_impl_._has_bits_[0], 0x00000002U);
-  }
-  _impl_.message_.SetAllocated(value, GetArena());
-  if (::google::protobuf::internal::DebugHardenForceCopyDefaultString() && _impl_.message_.IsDefault()) {
-    _impl_.message_.Set("", GetArena());
-  }
-  // @@protoc_insertion_point(field_set_allocated:ocr.ProcessImageResponse.message)
-}
-
-// int64 processing_time_ms = 4;
-inline void ProcessImageResponse::clear_processing_time_ms() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.processing_time_ms_ = ::int64_t{0};
-  ClearHasBit(_impl_._has_bits_[0],
-                  0x00000004U);
-}
-inline ::int64_t ProcessImageResponse::processing_time_ms() const {
-  // @@protoc_insertion_point(field_get:ocr.ProcessImageResponse.processing_time_ms)
-  return _internal_processing_time_ms();
-}
-inline void ProcessImageResponse::set_processing_time_ms(::int64_t value) {
-  _internal_set_processing_time_ms(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000004U);
-  // @@protoc_insertion_point(field_set:ocr.ProcessImageResponse.processing_time_ms)
-}
-inline ::int64_t ProcessImageResponse::_internal_processing_time_ms() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.processing_time_ms_;
-}
-inline void ProcessImageResponse::_internal_set_processing_time_ms(::int64_t value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.processing_time_ms_ = value;
-}
-
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif  // __GNUC__
-
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace ocr
-
-
-// @@protoc_insertion_point(global_scope)
-
-#include "google/protobuf/port_undef.inc"
-
-#endif  // ocr_2eproto_2epb_2eh
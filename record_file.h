@@ -0,0 +1,76 @@
+#ifndef RECORD_FILE_H
+#define RECORD_FILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <vector>
+
+// Append-only files written as [type][u32 field count]([u32 length][bytes])*,
+// little-endian. A reader stops at the first incomplete record, so a record
+// torn by a crash is simply dropped. Shared by the server's journal, text
+// index, templates and request captures, and by ocr_replay.
+inline void writeU32(FILE* file, uint32_t value) {
+    unsigned char bytes[4] = {
+        static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+        static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+    std::fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+inline bool readU32(std::istream& input, uint32_t& value) {
+    unsigned char bytes[4];
+    if (!input.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) return false;
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+inline void writeRecord(FILE* file, char type, const std::vector<std::string>& fields) {
+    std::fputc(type, file);
+    writeU32(file, static_cast<uint32_t>(fields.size()));
+    for (const std::string& field : fields) {
+        writeU32(file, static_cast<uint32_t>(field.size()));
+        std::fwrite(field.data(), 1, field.size(), file);
+    }
+}
+
+// Largest field a reader accepts; images are the biggest fields written.
+constexpr uint32_t kMaxRecordFieldBytes = 256u * 1024 * 1024;
+
+// Bytes left after the read position, or -1 when the stream cannot seek.
+inline std::streamoff remainingBytes(std::istream& input) {
+    std::streampos position = input.tellg();
+    if (position == std::streampos(-1)) return -1;
+    input.seekg(0, std::ios::end);
+    std::streampos end = input.tellg();
+    input.seekg(position);
+    if (end == std::streampos(-1) || !input) return -1;
+    return end - position;
+}
+
+// A field length is checked against kMaxRecordFieldBytes and the bytes left
+// in the stream before anything is allocated, so a corrupt length reads as
+// a torn record instead of a huge allocation.
+inline bool readRecord(std::istream& input, char& type, std::vector<std::string>& fields,
+                       uint32_t max_fields) {
+    fields.clear();
+    if (!input.get(type)) return false;
+    uint32_t count = 0;
+    if (!readU32(input, count) || count > max_fields) return false;
+    std::streamoff remaining = remainingBytes(input);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = 0;
+        if (!readU32(input, length) || length > kMaxRecordFieldBytes) return false;
+        if (remaining >= 0) {
+            remaining -= 4;
+            if (remaining < 0 || static_cast<std::streamoff>(length) > remaining) return false;
+            remaining -= length;
+        }
+        std::string field(length, '\0');
+        if (length > 0 && !input.read(&field[0], length)) return false;
+        fields.push_back(std::move(field));
+    }
+    return true;
+}
+
+#endif
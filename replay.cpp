@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+#include "ocr.grpc.pb.h"
+#include "request_capture.h"
+
+using ocr::OCRService;
+using ocr::ProcessImageRequest;
+using ocr::ProcessImageResponse;
+using ocr::SubmitImageResponse;
+
+// Replays a request capture written by `ocr_server --capture=FILE` against a
+// server, keeping the captured arrival times (scaled by --speed) and order.
+//
+//   ocr_replay CAPTURE [ENDPOINT] [--speed=X] [--max-in-flight=N] [--limit=N]
+//
+// --speed=2 replays twice as fast, --speed=0 sends as fast as the in-flight
+// limit allows. Requests whose image was not sampled into the capture are
+// sent the captured image closest in size, so load shape and payload sizes
+// stay close to the original while the capture stays small.
+
+struct ReplayOptions {
+    std::string capture_path;
+    std::string endpoint = "localhost:50051";
+    double speed = 1.0;
+    size_t max_in_flight = 64;
+    size_t limit = 0;  // 0 = every captured request
+};
+
+// CAPTURE LOADING ------------------------------------------------------------
+struct Capture {
+    std::vector<CapturedRequest> requests;
+    std::unordered_map<uint64_t, std::string> payloads;
+    std::multimap<uint64_t, uint64_t> hashes_by_size;
+};
+
+static bool loadCapture(const std::string& path, Capture& capture) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open()) return false;
+    char type = 0;
+    std::vector<std::string> fields;
+    if (!readRecord(input, type, fields, kCaptureMaxFields) || type != kCaptureHeaderRecord ||
+        fields.empty() || fields[0] != kCaptureFormat) {
+        std::cerr << "[Replay] Not a capture file: " << path << std::endl;
+        return false;
+    }
+    while (readRecord(input, type, fields, kCaptureMaxFields)) {
+        if (type == kCapturePayloadRecord && fields.size() == 2) {
+            uint64_t hash = 0;
+            try {
+                hash = std::stoull(fields[0], nullptr, 16);
+            } catch (const std::exception&) {
+                continue;
+            }
+            capture.hashes_by_size.emplace(fields[1].size(), hash);
+            capture.payloads[hash] = std::move(fields[1]);
+        } else if (type == kCaptureRequestRecord) {
+            CapturedRequest request;
+            if (parseCapturedRequest(fields, request)) capture.requests.push_back(std::move(request));
+        }
+    }
+    return true;
+}
+
+// The captured image itself, or else the sampled image nearest in size.
+static const std::string* payloadFor(const Capture& capture, const CapturedRequest& request,
+                                     bool& substituted) {
+    auto exact = capture.payloads.find(request.payload_hash);
+    substituted = exact == capture.payloads.end();
+    if (!substituted) return &exact->second;
+    if (capture.hashes_by_size.empty()) return nullptr;
+
+    auto above = capture.hashes_by_size.lower_bound(request.payload_size);
+    auto nearest = above;
+    if (above == capture.hashes_by_size.end()) {
+        nearest = std::prev(above);
+    } else if (above != capture.hashes_by_size.begin()) {
+        auto below = std::prev(above);
+        if (request.payload_size - below->first < above->first - request.payload_size) nearest = below;
+    }
+    return &capture.payloads.at(nearest->second);
+}
+//----------------------------------------------------------------------------
+
+// REPLAY ---------------------------------------------------------------------
+struct ReplayResults {
+    std::mutex mutex;
+    std::map<std::string, std::vector<double>> latencies_ms;  // by rpc
+    size_t ok = 0;
+    size_t refused = 0;      // answered with ok == false
+    size_t rpc_errors = 0;
+    size_t substituted = 0;
+    size_t skipped = 0;      // no payload at all in the capture
+    double max_lag_ms = 0.0; // how far sends fell behind the captured schedule
+};
+
+static void sendRequest(OCRService::Stub& stub, const CapturedRequest& captured,
+                        const std::string& image, ReplayResults& results, double lag_ms) {
+    ProcessImageRequest request;
+    request.set_client_id(captured.client_id);
+    request.set_batch_id(captured.batch_id);
+    request.set_filename(captured.filename);
+    request.set_image(image);
+    request.set_lang(captured.lang);
+    request.set_profile(captured.profile);
+    request.set_form_template(captured.form_template);
+    request.set_priority(static_cast<ocr::Priority>(captured.priority));
+    request.set_want_word_boxes(captured.want_word_boxes);
+
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(130));
+    auto started = std::chrono::steady_clock::now();
+    grpc::Status status;
+    bool ok = false;
+    if (captured.rpc == "SubmitImage") {
+        SubmitImageResponse response;
+        status = stub.SubmitImage(&context, request, &response);
+        ok = response.ok();
+    } else {
+        ProcessImageResponse response;
+        status = stub.ProcessImage(&context, request, &response);
+        ok = response.ok();
+    }
+    double latency_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
+
+    std::lock_guard<std::mutex> guard(results.mutex);
+    results.max_lag_ms = std::max(results.max_lag_ms, lag_ms);
+    if (!status.ok()) {
+        results.rpc_errors++;
+        return;
+    }
+    (ok ? results.ok : results.refused)++;
+    results.latencies_ms[captured.rpc].push_back(latency_ms);
+}
+
+// Each sender claims the next request in capture order and waits for its
+// scheduled time, so at most max_in_flight requests are outstanding and a
+// slow server shows up as lag rather than as reordering.
+static void replay(const Capture& capture, const ReplayOptions& options, ReplayResults& results) {
+    auto stub = OCRService::NewStub(
+        grpc::CreateChannel(options.endpoint, grpc::InsecureChannelCredentials()));
+    const size_t total = options.limit > 0 ? std::min(options.limit, capture.requests.size())
+                                           : capture.requests.size();
+    const uint64_t first_offset_us = total > 0 ? capture.requests.front().offset_us : 0;
+    std::atomic<size_t> next{0};
+    const auto started = std::chrono::steady_clock::now();
+
+    auto sender = [&] {
+        for (size_t index = next++; index < total; index = next++) {
+            const CapturedRequest& captured = capture.requests[index];
+            bool substituted = false;
+            const std::string* image = payloadFor(capture, captured, substituted);
+            if (!image) {
+                std::lock_guard<std::mutex> guard(results.mutex);
+                results.skipped++;
+                continue;
+            }
+            if (substituted) {
+                std::lock_guard<std::mutex> guard(results.mutex);
+                results.substituted++;
+            }
+
+            auto due = started;
+            if (options.speed > 0.0) {
+                due += std::chrono::microseconds(static_cast<int64_t>(
+                    (captured.offset_us - first_offset_us) / options.speed));
+                std::this_thread::sleep_until(due);
+            }
+            double lag_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - due).count();
+            sendRequest(*stub, captured, *image, results, options.speed > 0.0 ? lag_ms : 0.0);
+        }
+    };
+
+    std::vector<std::thread> senders;
+    for (size_t i = 0; i < std::max<size_t>(1, options.max_in_flight); ++i) senders.emplace_back(sender);
+    for (std::thread& thread : senders) thread.join();
+
+    double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double captured_s = total > 0 ? (capture.requests[total - 1].offset_us - first_offset_us) / 1e6 : 0.0;
+    std::cout << "[Replay] " << total << " requests in " << elapsed_s << " s (captured span "
+              << captured_s << " s, " << (elapsed_s > 0.0 ? total / elapsed_s : 0.0) << " req/s)"
+              << std::endl;
+}
+
+static double percentile(std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void printResults(ReplayResults& results) {
+    std::cout << "[Replay] ok=" << results.ok << " refused=" << results.refused
+              << " rpc_errors=" << results.rpc_errors << " skipped=" << results.skipped
+              << " substituted_payloads=" << results.substituted
+              << " max_lag_ms=" << results.max_lag_ms << std::endl;
+    for (auto& entry : results.latencies_ms) {
+        std::vector<double>& latencies = entry.second;
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "[Replay] " << entry.first << " latency ms: p50=" << percentile(latencies, 0.5)
+                  << " p90=" << percentile(latencies, 0.9) << " p99=" << percentile(latencies, 0.99)
+                  << " max=" << latencies.back() << " (" << latencies.size() << " answered)"
+                  << std::endl;
+    }
+}
+//----------------------------------------------------------------------------
+
+// COMMAND LINE ---------------------------------------------------------------
+static bool readFlag(const std::string& arg, const std::string& name, std::string& value) {
+    const std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+static bool parseOptions(int argc, char** argv, ReplayOptions& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        try {
+            if (readFlag(arg, "speed", value)) {
+                options.speed = std::max(0.0, std::stod(value));
+            } else if (readFlag(arg, "max-in-flight", value)) {
+                options.max_in_flight = std::stoul(value);
+            } else if (readFlag(arg, "limit", value)) {
+                options.limit = std::stoul(value);
+            } else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "Ignoring unknown option: " << arg << "\n";
+            } else {
+                positional.push_back(arg);
+            }
+        } catch (...) {
+            std::cerr << "Invalid value for " << arg << ", using default.\n";
+        }
+    }
+    if (positional.empty()) return false;
+    options.capture_path = positional[0];
+    if (positional.size() > 1) options.endpoint = positional[1];
+    return true;
+}
+//----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: ocr_replay CAPTURE [ENDPOINT] [--speed=X] [--max-in-flight=N] [--limit=N]\n";
+        return 2;
+    }
+
+    Capture capture;
+    if (!loadCapture(options.capture_path, capture)) {
+        std::cerr << "[Replay] Failed to read capture: " << options.capture_path << std::endl;
+        return 1;
+    }
+    std::cout << "[Replay] Loaded " << capture.requests.size() << " requests and "
+              << capture.payloads.size() << " payloads from " << options.capture_path
+              << ", replaying against " << options.endpoint << " at " << options.speed << "x"
+              << std::endl;
+
+    ReplayResults results;
+    replay(capture, options, results);
+    printResults(results);
+    return results.rpc_errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+#ifndef REQUEST_CAPTURE_H
+#define REQUEST_CAPTURE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "record_file.h"
+
+// Capture files (server --capture, read by ocr_replay) are record files:
+//   'H' {format, capture start as Unix milliseconds}
+//   'P' {payload hash, image bytes}, before the first request that carries a
+//       sampled payload; every payload is stored once
+//   'R' {CapturedRequest fields}, one per incoming request in arrival order
+// Numbers are decimal text, hashes the 16 hex digits of contentHash().
+constexpr const char* kCaptureFormat = "ocr-capture-1";
+constexpr char kCaptureHeaderRecord = 'H';
+constexpr char kCapturePayloadRecord = 'P';
+constexpr char kCaptureRequestRecord = 'R';
+constexpr uint32_t kCaptureMaxFields = 16;
+
+struct CapturedRequest {
+    uint64_t offset_us = 0;        // arrival time after the capture started
+    std::string rpc;               // "ProcessImage" or "SubmitImage"
+    std::string client_id;
+    std::string batch_id;
+    std::string filename;
+    std::string lang;
+    std::string profile;
+    std::string form_template;
+    int32_t priority = 0;
+    bool want_word_boxes = false;
+    uint64_t payload_hash = 0;
+    uint64_t payload_size = 0;
+};
+
+inline std::string captureHashText(uint64_t hash) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+inline std::vector<std::string> captureFields(const CapturedRequest& request) {
+    return {std::to_string(request.offset_us), request.rpc, request.client_id, request.batch_id,
+            request.filename, request.lang, request.profile, request.form_template,
+            std::to_string(request.priority), request.want_word_boxes ? "1" : "0",
+            captureHashText(request.payload_hash), std::to_string(request.payload_size)};
+}
+
+inline bool parseCapturedRequest(const std::vector<std::string>& fields, CapturedRequest& request) {
+    if (fields.size() < 12) return false;
+    try {
+        request.offset_us = std::stoull(fields[0]);
+        request.rpc = fields[1];
+        request.client_id = fields[2];
+        request.batch_id = fields[3];
+        request.filename = fields[4];
+        request.lang = fields[5];
+        request.profile = fields[6];
+        request.form_template = fields[7];
+        request.priority = std::stoi(fields[8]);
+        request.want_word_boxes = fields[9] == "1";
+        request.payload_hash = std::stoull(fields[10], nullptr, 16);
+        request.payload_size = std::stoull(fields[11]);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+#endif
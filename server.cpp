@@ -1,226 +1,4627 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cctype>
+#include <cmath>
 #include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <future>
+#include <iomanip>
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <random>
+#include <new>
+#include <set>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <grpcpp/grpcpp.h>
 #include "ocr.grpc.pb.h"
+#include "archive_reader.h"
+#include "content_hash.h"
+#include "record_file.h"
+#include "request_capture.h"
+#include "task_journal.h"
+#include "task_scheduling.h"
+#include "text_index.h"
 #include <tesseract/baseapi.h>
 #include <leptonica/allheaders.h>
+#include <sys/mman.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using grpc::Server;
 using grpc::ServerBuilder;
 using grpc::ServerContext;
+using grpc::ServerReaderWriter;
 using grpc::Status;
 
 using ocr::OCRService;
+using ocr::ArchiveChunk;
+using ocr::ArchiveEntryResult;
+using ocr::Frame;
+using ocr::FrameTextUpdate;
+using ocr::TextChange;
 using ocr::ProcessImageRequest;
 using ocr::ProcessImageResponse;
+using ocr::JobResultRequest;
+using ocr::JobResultResponse;
+using ocr::WordBoxes;
+using ocr::FormFieldResult;
+using ocr::RegisterTemplateRequest;
+using ocr::RegisterTemplateResponse;
+using ocr::SetFaultsRequest;
+using ocr::SetFaultsResponse;
+using ocr::SearchHit;
+using ocr::SearchRequest;
+using ocr::SearchResponse;
+using ocr::AllocationProfile;
+using ocr::StageAllocation;
+using ocr::SubmitImageResponse;
+using ocr::StatsRequest;
+using ocr::StatsResponse;
+using ocr::StealTasksRequest;
+using ocr::StealTasksResponse;
+using ocr::StolenTask;
+using ocr::StolenTaskAck;
+using ocr::StolenTaskResult;
+
+struct ServerOptions {
+    size_t worker_threads = 4;
+    std::string endpoint = "0.0.0.0:50051";
+    size_t process_count = 1;
+    int stats_interval_seconds = 30;
+    std::string tessdata_path = "/opt/homebrew/share/tessdata";
+    std::string profiles_path;
+    size_t recycle_after_tasks = 0;
+    size_t recycle_above_rss_mb = 0;
+    size_t cache_entries = 1024;
+    size_t tile_cache_entries = 0;
+    bool shortest_job_first = false;
+    long long sjf_aging_ms = 500;
+    long long max_queue_eta_ms = 0;
+    size_t interactive_workers = 0;
+    double parallel_preprocess_mp = 0.0;
+    bool allocation_profiling = false;
+    uint64_t max_image_megapixels = 400;
+    uint64_t max_decoded_mb = 2048;
+    bool downsample_oversize = false;
+    std::string capture_path;
+    double capture_sample_rate = 0.01;
+    std::vector<std::string> peer_endpoints;
+    int steal_lease_seconds = 30;
+    std::string wal_directory;
+    size_t job_results = 10000;
+    int near_duplicate_distance = -1;
+    size_t near_duplicate_entries = 10000;
+    std::string index_directory;
+    std::string template_directory = "templates";
+    std::string shadow_profile;
+    double shadow_sample_rate = 0.0;
+    bool fault_injection = false;
+    std::vector<std::string> fault_rules;
+    bool osd_enabled = false;
+    std::map<std::string, std::string> osd_script_languages = {{"Latin", "eng"}};
+};
+
+static volatile std::sig_atomic_t shutdown_signal_received = 0;
+
+static void handleShutdownSignal(int) {
+    shutdown_signal_received = 1;
+}
+
+static void installShutdownHandlers() {
+    std::signal(SIGINT, handleShutdownSignal);
+    std::signal(SIGTERM, handleShutdownSignal);
+}
+
+// RECOGNITION PROFILES -------------------------------------------------------
+// A profile is a named engine configuration: language, page segmentation mode,
+// binarization and Tesseract variables. Every worker keeps one initialized
+// engine per profile, so init-only variables (dictionaries) cost nothing per
+// request.
+struct RecognitionProfile {
+    std::string name;
+    std::string language = "eng";
+    tesseract::PageSegMode page_seg_mode = tesseract::PSM_AUTO;
+    // Sauvola binarization in the worker instead of gamma correction followed
+    // by Tesseract's own global threshold.
+    bool sauvola = false;
+    int sauvola_window = 25;
+    float sauvola_k = 0.34f;
+    std::vector<std::pair<std::string, std::string>> variables;
+};
+
+class ProfileCatalog {
+public:
+    static constexpr const char* kDefaultProfile = "default";
+
+    ProfileCatalog() {
+        RecognitionProfile default_profile;
+        default_profile.name = kDefaultProfile;
+        add(default_profile);
+
+        RecognitionProfile digits;
+        digits.name = "digits";
+        digits.page_seg_mode = tesseract::PSM_SINGLE_BLOCK;
+        digits.variables = {
+            {"tessedit_char_whitelist", "0123456789"},
+            {"load_system_dawg", "0"},
+            {"load_freq_dawg", "0"},
+        };
+        add(digits);
+    }
+
+    // Reads an INI-style file of [profile] sections holding "lang = ...",
+    // "psm = N", "binarize = sauvola" (with optional "sauvola_window" and
+    // "sauvola_k") and any other "tesseract_variable = value" lines. Sections
+    // with the name of a built-in profile replace it.
+    bool loadFile(const std::string& path) {
+        std::ifstream input(path);
+        if (!input.is_open()) return false;
+
+        RecognitionProfile current;
+        bool in_section = false;
+        std::string line;
+        while (std::getline(input, line)) {
+            line = trim(line);
+            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+            if (line.front() == '[' && line.back() == ']') {
+                if (in_section) add(current);
+                current = RecognitionProfile();
+                current.name = trim(line.substr(1, line.size() - 2));
+                in_section = !current.name.empty();
+                continue;
+            }
+
+            size_t separator = line.find('=');
+            if (!in_section || separator == std::string::npos) {
+                std::cerr << "[Profiles] Ignoring line: " << line << std::endl;
+                continue;
+            }
+            std::string key = trim(line.substr(0, separator));
+            std::string value = trim(line.substr(separator + 1));
+            if (key == "lang") {
+                current.language = value;
+            } else if (key == "psm") {
+                try {
+                    current.page_seg_mode = static_cast<tesseract::PageSegMode>(std::stoi(value));
+                } catch (...) {
+                    std::cerr << "[Profiles] Invalid psm for " << current.name << std::endl;
+                }
+            } else if (key == "binarize") {
+                current.sauvola = value == "sauvola";
+            } else if (key == "sauvola_window" || key == "sauvola_k") {
+                try {
+                    if (key == "sauvola_window") current.sauvola_window = std::max(3, std::stoi(value) | 1);
+                    else current.sauvola_k = std::stof(value);
+                } catch (...) {
+                    std::cerr << "[Profiles] Invalid " << key << " for " << current.name << std::endl;
+                }
+            } else {
+                current.variables.emplace_back(key, value);
+            }
+        }
+        if (in_section) add(current);
+        return true;
+    }
+
+    const RecognitionProfile* find(const std::string& name) const {
+        auto it = profiles_.find(name.empty() ? kDefaultProfile : name);
+        return it == profiles_.end() ? nullptr : &it->second;
+    }
+
+    const std::map<std::string, RecognitionProfile>& all() const { return profiles_; }
+
+private:
+    void add(const RecognitionProfile& profile) { profiles_[profile.name] = profile; }
+
+    static std::string trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    std::map<std::string, RecognitionProfile> profiles_;
+};
+
+// Variables are passed to Init rather than SetVariable so that init-only
+// settings such as load_system_dawg take effect.
+static bool initializeEngine(tesseract::TessBaseAPI& engine,
+                             const RecognitionProfile& profile,
+                             const std::string& tessdata_path) {
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    for (const auto& variable : profile.variables) {
+        names.push_back(variable.first);
+        values.push_back(variable.second);
+    }
+    if (engine.Init(tessdata_path.c_str(), profile.language.c_str(),
+                    tesseract::OEM_DEFAULT, nullptr, 0, &names, &values, false)) {
+        return false;
+    }
+    engine.SetPageSegMode(profile.page_seg_mode);
+    return true;
+}
+//----------------------------------------------------------------------------
+
+// ALLOCATION PROFILING -------------------------------------------------------
+// With --alloc-profile, in a build with OCR_ALLOC_PROFILE, every operator
+// new/delete and every Leptonica pixel buffer is counted on the calling
+// thread: allocations, bytes, live bytes and their peak. Block sizes are asked from malloc, so blocks allocated before
+// counting started are freed correctly; a block freed on another thread
+// lowers that thread's live bytes. Workers read the counters between the
+// pipeline stages of a task, so helper threads (parallel strips) and gRPC
+// threads are not attributed to tasks.
+static std::atomic<bool> g_allocation_profiling{false};
+
+struct AllocationCounters {
+    uint64_t allocations;
+    uint64_t bytes;
+    int64_t live_bytes;
+    int64_t peak_live_bytes;
+};
+// Constant-initialized, so operator new never runs a thread_local constructor.
+static thread_local AllocationCounters t_allocations = {0, 0, 0, 0};
+
+static size_t allocatedBlockSize(void* block) {
+#if defined(__APPLE__)
+    return malloc_size(block);
+#else
+    return malloc_usable_size(block);
+#endif
+}
+
+static void countAllocation(void* block) {
+    if (!block || !g_allocation_profiling.load(std::memory_order_relaxed)) return;
+    const size_t bytes = allocatedBlockSize(block);
+    AllocationCounters& counters = t_allocations;
+    counters.allocations++;
+    counters.bytes += bytes;
+    counters.live_bytes += static_cast<int64_t>(bytes);
+    if (counters.live_bytes > counters.peak_live_bytes) counters.peak_live_bytes = counters.live_bytes;
+}
+
+static void* countedMalloc(size_t size) {
+    void* block = std::malloc(size == 0 ? 1 : size);
+    countAllocation(block);
+    return block;
+}
+
+// posix_memalign blocks are released with free, so countedFree serves both.
+static void* countedAlignedMalloc(size_t size, size_t alignment) {
+    void* block = nullptr;
+    if (posix_memalign(&block, std::max(alignment, sizeof(void*)), size == 0 ? 1 : size) != 0) {
+        return nullptr;
+    }
+    countAllocation(block);
+    return block;
+}
+
+static void countedFree(void* block) {
+    if (!block) return;
+    if (g_allocation_profiling.load(std::memory_order_relaxed)) {
+        t_allocations.live_bytes -= static_cast<int64_t>(allocatedBlockSize(block));
+    }
+    std::free(block);
+}
+
+static constexpr size_t kAllocationStages = 3;
+static const char* const kAllocationStageNames[kAllocationStages] = {"decode", "preprocess", "recognize"};
+
+struct AllocationSample {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t peak_live_bytes = 0;  // above the live bytes when the stage began
+};
+
+// Reads the calling thread's counters in consecutive stages of one task.
+class AllocationMeter {
+public:
+    AllocationMeter() : task_live_bytes_(t_allocations.live_bytes) { startStage(); }
+
+    // Closes the current stage and starts the next.
+    AllocationSample lap() {
+        const AllocationCounters& counters = t_allocations;
+        AllocationSample sample;
+        sample.allocations = counters.allocations - stage_allocations_;
+        sample.bytes = counters.bytes - stage_bytes_;
+        sample.peak_live_bytes = static_cast<uint64_t>(
+            std::max<int64_t>(0, counters.peak_live_bytes - stage_live_bytes_));
+        task_peak_bytes_ = std::max(task_peak_bytes_, static_cast<uint64_t>(
+            std::max<int64_t>(0, counters.peak_live_bytes - task_live_bytes_)));
+        startStage();
+        return sample;
+    }
+
+    uint64_t taskPeakBytes() const { return task_peak_bytes_; }
+
+private:
+    void startStage() {
+        AllocationCounters& counters = t_allocations;
+        stage_allocations_ = counters.allocations;
+        stage_bytes_ = counters.bytes;
+        stage_live_bytes_ = counters.live_bytes;
+        counters.peak_live_bytes = counters.live_bytes;
+    }
+
+    int64_t task_live_bytes_;
+    uint64_t task_peak_bytes_ = 0;
+    uint64_t stage_allocations_ = 0;
+    uint64_t stage_bytes_ = 0;
+    int64_t stage_live_bytes_ = 0;
+};
+
+static void enableAllocationProfiling() {
+    g_allocation_profiling = true;
+    setPixMemoryManager(countedMalloc, countedFree);
+}
+//----------------------------------------------------------------------------
+
+// Cheap per-image inputs of the recognition cost model. Pixel count and
+// depth come from the image header; ink density is measured once decoded.
+struct CostFeatures {
+    double megapixels = 0.0;
+    int depth_bits = 8;
+    double ink_density = -1.0;  // unknown until a worker has the gray page
+};
 
 struct OcrTask {
+    uint64_t task_id = 0;
+    std::string job_id;
+    std::string cache_key;
+    std::string batch_id;
+    std::string batch_key;
+    bool has_perceptual_hash = false;
+    uint64_t perceptual_hash = 0;
     std::string file_name;
     std::string language_code;
+    std::string profile_name;
+    bool want_word_boxes = false;
+    WordBoxes word_boxes;
+    std::string form_template;
+    bool template_matched = false;
+    std::vector<FormFieldResult> form_fields;
     std::vector<unsigned char> image_data;
     std::promise<std::string> text_promise;
     std::chrono::steady_clock::time_point task_start_time;
+    long long recognition_ms = 0;  // time spent on a worker, excluding queueing
+    CostFeatures cost_features;
+    double predicted_ms = -1.0;    // cost model estimate, set when the task is queued
+    bool interactive = true;       // lane: interactive, or bulk when false
+    // Word boxes must stay in the coordinates of the submitted image, so OSD
+    // may not turn it (frame regions). Never lent to a peer.
+    bool keep_orientation = false;
+    bool failed = false;
+    // Per-stage allocation counts, filled when --alloc-profile is on.
+    std::array<AllocationSample, kAllocationStages> allocation_stages{};
+    uint64_t allocation_peak_bytes = 0;
+    // Mirrored copy run against the shadow profile; never reaches a client.
+    bool shadow = false;
+    // Set when no handler waits on the promise (tasks pulled from a peer,
+    // archive entries, shadow copies). Such tasks are never lent to a peer.
+    std::function<void(const OcrTask& task, const std::string& text)> on_complete;
 };
 
-// MULTITHREADING -----------------------------------------------------------
-class TaskProcessor {
+// STATISTICS ---------------------------------------------------------------
+// One slot per server process. Counters are lock-free atomics so that forked
+// children can update their own slot while any process reads all of them.
+struct ProcessStats {
+    std::atomic<int32_t> pid{0};
+    std::atomic<int32_t> worker_count{0};
+    std::atomic<int32_t> workers_ready{0};
+    std::atomic<int32_t> workers_failed{0};
+    std::atomic<int64_t> pending_tasks{0};
+    std::atomic<uint64_t> tasks_submitted{0};
+    std::atomic<uint64_t> tasks_completed{0};
+    std::atomic<uint64_t> tasks_failed{0};
+    std::atomic<uint64_t> tasks_timed_out{0};
+    std::atomic<uint64_t> total_processing_ms{0};
+    std::atomic<uint64_t> engine_recycles{0};
+    std::atomic<uint64_t> resident_bytes{0};
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> tasks_stolen{0};
+    std::atomic<uint64_t> tasks_donated{0};
+    std::atomic<uint64_t> tasks_replayed{0};
+    std::atomic<uint64_t> osd_runs{0};
+    std::atomic<uint64_t> osd_batch_hits{0};
+    std::atomic<uint64_t> pages_rotated{0};
+    std::atomic<uint64_t> near_duplicate_hits{0};
+    std::atomic<uint64_t> indexed_documents{0};
+    std::atomic<uint64_t> template_matches{0};
+    std::atomic<uint64_t> template_misses{0};
+    std::atomic<uint64_t> shadow_runs{0};
+    std::atomic<uint64_t> shadow_skipped{0};
+    std::atomic<uint64_t> shadow_identical{0};
+    std::atomic<uint64_t> shadow_word_edits{0};
+    std::atomic<uint64_t> shadow_words{0};
+    std::atomic<uint64_t> shadow_primary_ms{0};
+    std::atomic<uint64_t> shadow_ms{0};
+    std::atomic<uint64_t> faults_injected{0};
+    std::atomic<uint64_t> archive_entries{0};
+    std::atomic<uint64_t> frames_received{0};
+    std::atomic<uint64_t> frames_unchanged{0};
+    std::atomic<uint64_t> frame_regions_recognized{0};
+    std::atomic<uint64_t> tile_hits{0};
+    std::atomic<uint64_t> tile_misses{0};
+    std::atomic<uint64_t> cost_predictions{0};
+    std::atomic<uint64_t> cost_abs_error_ms{0};
+    std::atomic<uint64_t> cost_actual_ms{0};
+    std::atomic<uint64_t> tasks_rejected{0};
+    std::atomic<int64_t> pending_interactive{0};
+    std::atomic<uint64_t> sauvola_pages{0};
+    std::atomic<uint64_t> sauvola_us{0};
+    std::atomic<uint64_t> gamma_pages{0};
+    std::atomic<uint64_t> gamma_us{0};
+    std::atomic<uint64_t> parallel_preprocess_pages{0};
+    std::atomic<uint64_t> profiled_tasks{0};
+    std::array<std::atomic<uint64_t>, kAllocationStages> stage_allocations{};
+    std::array<std::atomic<uint64_t>, kAllocationStages> stage_allocated_bytes{};
+    std::array<std::atomic<uint64_t>, kAllocationStages> stage_peak_bytes{};  // largest single task
+    std::atomic<uint64_t> task_peak_bytes{0};
+    std::atomic<uint64_t> images_oversize{0};
+    std::atomic<uint64_t> images_downsampled{0};
+    std::atomic<uint64_t> captured_requests{0};
+    std::atomic<uint64_t> captured_payload_bytes{0};
+};
+
+static void raiseToAtLeast(std::atomic<uint64_t>& counter, uint64_t value) {
+    uint64_t current = counter.load();
+    while (current < value && !counter.compare_exchange_weak(current, value)) {}
+}
+
+class StatsRegistry {
 public:
-    TaskProcessor(size_t worker_count) : shutdown_requested_(false) {
-        for (size_t i = 0; i < worker_count; ++i) {
-            workers_.emplace_back(&TaskProcessor::processTasks, this);
+    // With more than one slot the block is mapped MAP_SHARED before fork(),
+    // so the supervisor and every child see the same counters.
+    explicit StatsRegistry(size_t slot_count)
+        : slot_count_(slot_count == 0 ? 1 : slot_count), local_index_(0) {
+        mapped_bytes_ = sizeof(ProcessStats) * slot_count_;
+        void* memory = mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("Failed to map shared stats block");
         }
+        slots_ = static_cast<ProcessStats*>(memory);
+        for (size_t i = 0; i < slot_count_; ++i) new (&slots_[i]) ProcessStats();
     }
 
-    ~TaskProcessor() {
-        stopProcessing();
+    ~StatsRegistry() {
+        for (size_t i = 0; i < slot_count_; ++i) slots_[i].~ProcessStats();
+        munmap(slots_, mapped_bytes_);
     }
-//----------------------------------------------------------------------------
 
-// SYNCHRONIZATION -----------------------------------------------------------
-    void submitTask(std::shared_ptr<OcrTask> task) {
-        {
-            std::lock_guard<std::mutex> guard(queue_mutex_);
-            pending_tasks_.push(task);
-            std::cout << "[Queue] Task submitted: " << task->file_name
-                      << ", Pending tasks: " << pending_tasks_.size() << std::endl;
-        }
-        task_available_.notify_one();
+    StatsRegistry(const StatsRegistry&) = delete;
+    StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+    void setLocalIndex(size_t index) {
+        local_index_ = index;
+        ProcessStats& own = local();
+        own.pid = static_cast<int32_t>(getpid());
+        own.pending_tasks = 0;
     }
 
-    void stopProcessing() {
-        {
-            std::lock_guard<std::mutex> guard(queue_mutex_);
-            if (shutdown_requested_) return;
-            shutdown_requested_ = true;
+    void releaseSlot(size_t index) {
+        slots_[index].pid = 0;
+        slots_[index].worker_count = 0;
+        slots_[index].workers_ready = 0;
+        slots_[index].workers_failed = 0;
+        slots_[index].pending_tasks = 0;
+    }
+
+    ProcessStats& local() { return slots_[local_index_]; }
+    size_t localIndex() const { return local_index_; }
+    size_t slotCount() const { return slot_count_; }
+
+    void fillResponse(StatsResponse* response) const {
+        int32_t live_processes = 0;
+        for (size_t i = 0; i < slot_count_; ++i) {
+            const ProcessStats& slot = slots_[i];
+            if (slot.pid.load() != 0) ++live_processes;
+            response->set_worker_count(response->worker_count() + slot.worker_count.load());
+            response->set_workers_ready(response->workers_ready() + slot.workers_ready.load());
+            response->set_workers_failed(response->workers_failed() + slot.workers_failed.load());
+            response->set_pending_tasks(response->pending_tasks() + slot.pending_tasks.load());
+            response->set_tasks_submitted(response->tasks_submitted() + slot.tasks_submitted.load());
+            response->set_tasks_completed(response->tasks_completed() + slot.tasks_completed.load());
+            response->set_tasks_failed(response->tasks_failed() + slot.tasks_failed.load());
+            response->set_tasks_timed_out(response->tasks_timed_out() + slot.tasks_timed_out.load());
+            response->set_total_processing_ms(response->total_processing_ms()
+                                              + slot.total_processing_ms.load());
+            response->set_engine_recycles(response->engine_recycles() + slot.engine_recycles.load());
+            response->set_resident_bytes(response->resident_bytes() + slot.resident_bytes.load());
+            response->set_cache_hits(response->cache_hits() + slot.cache_hits.load());
+            response->set_cache_misses(response->cache_misses() + slot.cache_misses.load());
+            response->set_tasks_stolen(response->tasks_stolen() + slot.tasks_stolen.load());
+            response->set_tasks_donated(response->tasks_donated() + slot.tasks_donated.load());
+            response->set_tasks_replayed(response->tasks_replayed() + slot.tasks_replayed.load());
+            response->set_osd_runs(response->osd_runs() + slot.osd_runs.load());
+            response->set_osd_batch_hits(response->osd_batch_hits() + slot.osd_batch_hits.load());
+            response->set_pages_rotated(response->pages_rotated() + slot.pages_rotated.load());
+            response->set_near_duplicate_hits(response->near_duplicate_hits()
+                                              + slot.near_duplicate_hits.load());
+            response->set_indexed_documents(response->indexed_documents()
+                                            + slot.indexed_documents.load());
+            response->set_template_matches(response->template_matches() + slot.template_matches.load());
+            response->set_template_misses(response->template_misses() + slot.template_misses.load());
+            response->set_shadow_runs(response->shadow_runs() + slot.shadow_runs.load());
+            response->set_shadow_skipped(response->shadow_skipped() + slot.shadow_skipped.load());
+            response->set_shadow_identical(response->shadow_identical() + slot.shadow_identical.load());
+            response->set_shadow_word_edits(response->shadow_word_edits() + slot.shadow_word_edits.load());
+            response->set_shadow_words(response->shadow_words() + slot.shadow_words.load());
+            response->set_shadow_primary_ms(response->shadow_primary_ms() + slot.shadow_primary_ms.load());
+            response->set_shadow_ms(response->shadow_ms() + slot.shadow_ms.load());
+            response->set_faults_injected(response->faults_injected() + slot.faults_injected.load());
+            response->set_archive_entries(response->archive_entries() + slot.archive_entries.load());
+            response->set_frames_received(response->frames_received() + slot.frames_received.load());
+            response->set_frames_unchanged(response->frames_unchanged() + slot.frames_unchanged.load());
+            response->set_frame_regions_recognized(response->frame_regions_recognized()
+                                                   + slot.frame_regions_recognized.load());
+            response->set_tile_hits(response->tile_hits() + slot.tile_hits.load());
+            response->set_tile_misses(response->tile_misses() + slot.tile_misses.load());
+            response->set_cost_predictions(response->cost_predictions() + slot.cost_predictions.load());
+            response->set_cost_abs_error_ms(response->cost_abs_error_ms() + slot.cost_abs_error_ms.load());
+            response->set_cost_actual_ms(response->cost_actual_ms() + slot.cost_actual_ms.load());
+            response->set_tasks_rejected(response->tasks_rejected() + slot.tasks_rejected.load());
+            response->set_pending_interactive(response->pending_interactive() + slot.pending_interactive.load());
+            response->set_sauvola_pages(response->sauvola_pages() + slot.sauvola_pages.load());
+            response->set_sauvola_us(response->sauvola_us() + slot.sauvola_us.load());
+            response->set_gamma_pages(response->gamma_pages() + slot.gamma_pages.load());
+            response->set_gamma_us(response->gamma_us() + slot.gamma_us.load());
+            response->set_parallel_preprocess_pages(response->parallel_preprocess_pages()
+                                                    + slot.parallel_preprocess_pages.load());
+            response->set_profiled_tasks(response->profiled_tasks() + slot.profiled_tasks.load());
+            response->set_task_peak_bytes(std::max<uint64_t>(response->task_peak_bytes(),
+                                                              slot.task_peak_bytes.load()));
+            response->set_images_oversize(response->images_oversize() + slot.images_oversize.load());
+            response->set_images_downsampled(response->images_downsampled()
+                                             + slot.images_downsampled.load());
+            response->set_captured_requests(response->captured_requests() + slot.captured_requests.load());
+            response->set_captured_payload_bytes(response->captured_payload_bytes()
+                                                 + slot.captured_payload_bytes.load());
         }
-        task_available_.notify_all();
-        for (auto &worker_thread : workers_) {
-            if (worker_thread.joinable()) worker_thread.join();
+        response->set_process_count(live_processes);
+        if (response->profiled_tasks() == 0) return;
+        for (size_t stage = 0; stage < kAllocationStages; ++stage) {
+            StageAllocation* total = response->add_allocation_stages();
+            total->set_stage(kAllocationStageNames[stage]);
+            for (size_t i = 0; i < slot_count_; ++i) {
+                const ProcessStats& slot = slots_[i];
+                total->set_allocations(total->allocations() + slot.stage_allocations[stage].load());
+                total->set_bytes(total->bytes() + slot.stage_allocated_bytes[stage].load());
+                total->set_peak_live_bytes(std::max<uint64_t>(total->peak_live_bytes(),
+                                                              slot.stage_peak_bytes[stage].load()));
+            }
         }
     }
-//----------------------------------------------------------------------------
+
+    void printSummary(const std::string& prefix) const {
+        StatsResponse totals;
+        fillResponse(&totals);
+        std::cout << prefix << " processes=" << totals.process_count()
+                  << " workers=" << totals.worker_count()
+                  << " pending=" << totals.pending_tasks()
+                  << " submitted=" << totals.tasks_submitted()
+                  << " completed=" << totals.tasks_completed()
+                  << " failed=" << totals.tasks_failed()
+                  << " timed_out=" << totals.tasks_timed_out()
+                  << " recycles=" << totals.engine_recycles()
+                  << " cache_hits=" << totals.cache_hits()
+                  << " near_dup_hits=" << totals.near_duplicate_hits()
+                  << " stolen=" << totals.tasks_stolen()
+                  << " donated=" << totals.tasks_donated()
+                  << " rss_mb=" << totals.resident_bytes() / (1024 * 1024) << std::endl;
+    }
 
 private:
-    void processTasks() {
-        tesseract::TessBaseAPI ocr_engine;
-        if (ocr_engine.Init("/opt/homebrew/share/tessdata", "eng")) {
-            std::cerr << "[Worker " << std::this_thread::get_id()
-                      << "] OCR engine initialization failed!" << std::endl;
+    size_t slot_count_;
+    size_t local_index_;
+    size_t mapped_bytes_;
+    ProcessStats* slots_;
+};
+//----------------------------------------------------------------------------
+
+// RESULT CACHE ---------------------------------------------------------------
+// LRU of recognized text keyed by profile and image content. Clients that
+// route by content hash send duplicates to the same node, so its cache sees
+// every copy of an image instead of a round-robin slice.
+class ResultCache {
+public:
+    explicit ResultCache(size_t capacity) : capacity_(capacity) {}
+
+    bool enabled() const { return capacity_ > 0; }
+
+    static std::string makeKey(const std::string& profile_name, const std::string& image) {
+        std::ostringstream key;
+        key << profile_name << ':' << std::hex << std::setw(16) << std::setfill('0')
+            << contentHash(image) << ':' << std::dec << image.size();
+        return key.str();
+    }
+
+    bool lookup(const std::string& key, std::string& text) {
+        if (capacity_ == 0) return false;
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end()) return false;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        text = it->second->second;
+        return true;
+    }
+
+    void insert(const std::string& key, const std::string& text) {
+        if (capacity_ == 0) return;
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            it->second->second = text;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
         }
+        entries_.emplace_front(key, text);
+        index_[key] = entries_.begin();
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
 
-        while (true) {
-            std::shared_ptr<OcrTask> current_task;
-            {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
-                task_available_.wait(lock, [&] {
-                    return shutdown_requested_ || !pending_tasks_.empty();
-                });
+private:
+    using Entry = std::pair<std::string, std::string>;
 
-                if (shutdown_requested_ && pending_tasks_.empty()) return;
+    size_t capacity_;
+    std::mutex mutex_;
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+//----------------------------------------------------------------------------
 
-                current_task = pending_tasks_.front();
-                pending_tasks_.pop();
+// IMAGE LIMITS ---------------------------------------------------------------
+// A few hundred bytes of PNG can declare a 60000x60000 page. Every decode
+// goes through the header first: pages over the pixel or decoded-size limit
+// are refused, or with downsampling on, JPEGs are decoded at 1/2, 1/4 or 1/8
+// scale by libjpeg itself, so the full-size raster never exists. Other
+// formats cannot be reduced while decoding and are always refused.
+struct ImageLimits {
+    uint64_t max_pixels = 0;         // 0 = unlimited
+    uint64_t max_decoded_bytes = 0;  // 0 = unlimited
+    bool downsample = false;
 
-                std::cout << "[Queue] Task dequeued: " << current_task->file_name
-                          << ", Pending tasks: " << pending_tasks_.size() << std::endl;
+    bool enabled() const { return max_pixels > 0 || max_decoded_bytes > 0; }
+};
+
+// On success `reduction` is 1, or the JPEG scale-down to decode with.
+static bool checkImageLimits(const l_uint8* data, size_t size, const ImageLimits& limits,
+                             int& reduction, std::string& error) {
+    reduction = 1;
+    if (!limits.enabled()) return true;
+    l_int32 format = 0, width = 0, height = 0, bits = 0, samples = 0, colormap = 0;
+    if (size == 0 || pixReadHeaderMem(data, size, &format, &width, &height, &bits, &samples,
+                                      &colormap) != 0 || width <= 0 || height <= 0) {
+        error = "Unreadable image header";
+        return false;
+    }
+    // RGB(A) decodes to 32 bpp; everything else keeps its depth.
+    const uint64_t depth = samples >= 3 ? 32 : static_cast<uint64_t>(std::max(1, bits));
+    auto fits = [&](int scale) {
+        const uint64_t scaled_width = (static_cast<uint64_t>(width) + scale - 1) / scale;
+        const uint64_t scaled_height = (static_cast<uint64_t>(height) + scale - 1) / scale;
+        const uint64_t bytes = (scaled_width * depth + 31) / 32 * 4 * scaled_height;
+        return (limits.max_pixels == 0 || scaled_width * scaled_height <= limits.max_pixels) &&
+               (limits.max_decoded_bytes == 0 || bytes <= limits.max_decoded_bytes);
+    };
+    if (fits(1)) return true;
+    if (limits.downsample && format == IFF_JFIF_JPEG) {
+        for (int scale : {2, 4, 8}) {
+            if (fits(scale)) {
+                reduction = scale;
+                return true;
             }
+        }
+    }
+    error = "Image too large: " + std::to_string(width) + "x" + std::to_string(height) +
+            " at " + std::to_string(depth) + " bpp exceeds the server's decode limits";
+    return false;
+}
 
-            std::cout << "[Worker " << std::this_thread::get_id() 
-                      << "] Started processing: " << current_task->file_name << std::endl;
+// Decodes after checkImageLimits; nullptr with `error` set when refused.
+static Pix* decodeLimitedImage(const l_uint8* data, size_t size, const ImageLimits& limits,
+                               ProcessStats& stats, std::string& error) {
+    int reduction = 1;
+    if (!checkImageLimits(data, size, limits, reduction, error)) {
+        stats.images_oversize++;
+        return nullptr;
+    }
+    Pix* image_pix = nullptr;
+    if (reduction > 1) {
+        stats.images_downsampled++;
+        image_pix = pixReadMemJpeg(data, size, 0, reduction, nullptr, 0);
+    } else {
+        image_pix = pixReadMem(data, size);
+    }
+    if (!image_pix) error = "Failed to decode image";
+    return image_pix;
+}
 
-            std::string extracted_text;
+static Pix* decodeLimitedImage(const std::string& image, const ImageLimits& limits,
+                               ProcessStats& stats, std::string& error) {
+    return decodeLimitedImage(reinterpret_cast<const l_uint8*>(image.data()), image.size(),
+                              limits, stats, error);
+}
+//----------------------------------------------------------------------------
 
-            try {
-                Pix* image_pix = pixReadMem(current_task->image_data.data(),
-                                            current_task->image_data.size());
+// NEAR-DUPLICATE INDEX -------------------------------------------------------
+// A rescanned page differs in every byte but not in its low frequencies. The
+// DCT hash keeps the sign of the 8x8 lowest DCT coefficients (minus DC) of
+// the page scaled to 32x32 gray, relative to their median, so two scans of
+// the same document land a few bits apart.
+static bool perceptualHash(const std::string& image, const ImageLimits& limits,
+                           ProcessStats& stats, uint64_t& hash) {
+    std::string error;
+    Pix* image_pix = decodeLimitedImage(image, limits, stats, error);
+    if (!image_pix) return false;
+    Pix* gray_pix = pixConvertTo8(image_pix, 0);
+    pixDestroy(&image_pix);
+    if (!gray_pix) return false;
+    Pix* small_pix = pixScaleToSize(gray_pix, 32, 32);
+    pixDestroy(&gray_pix);
+    if (!small_pix) return false;
 
-                if (!image_pix) {
-                    extracted_text.clear();
-                    std::cout << "[Worker " << std::this_thread::get_id()
-                              << "] Failed to read image: " << current_task->file_name << std::endl;
-                } else {
-                    // PREPROCESSING
-                    Pix* gray_pix = pixConvertTo8(image_pix, 0);
-                    pixDestroy(&image_pix);
+    double pixels[32][32];
+    l_uint32* data = pixGetData(small_pix);
+    int words_per_line = pixGetWpl(small_pix);
+    for (int y = 0; y < 32; ++y) {
+        l_uint32* line = data + y * words_per_line;
+        for (int x = 0; x < 32; ++x) pixels[y][x] = GET_DATA_BYTE(line, x);
+    }
+    pixDestroy(&small_pix);
 
-                    Pix* enhanced_pix = pixGammaTRC(nullptr, gray_pix, 1.2f, 50, 180);
-                    pixDestroy(&gray_pix);
+    static const auto cosines = [] {
+        std::vector<std::vector<double>> table(8, std::vector<double>(32));
+        for (int u = 0; u < 8; ++u) {
+            for (int x = 0; x < 32; ++x) table[u][x] = std::cos((2 * x + 1) * u * 3.14159265358979323846 / 64.0);
+        }
+        return table;
+    }();
 
-                    ocr_engine.SetImage(enhanced_pix);
+    double coefficients[64];
+    for (int v = 0; v < 8; ++v) {
+        for (int u = 0; u < 8; ++u) {
+            double sum = 0.0;
+            for (int y = 0; y < 32; ++y) {
+                double row = 0.0;
+                for (int x = 0; x < 32; ++x) row += pixels[y][x] * cosines[u][x];
+                sum += row * cosines[v][y];
+            }
+            coefficients[v * 8 + u] = sum;
+        }
+    }
 
-                    char* ocr_result = ocr_engine.GetUTF8Text();
-                    if (ocr_result) {
-                        extracted_text = std::string(ocr_result);
-                        delete [] ocr_result;
-                    }
+    std::vector<double> sorted(coefficients + 1, coefficients + 64);
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    double median = sorted[sorted.size() / 2];
 
-                    pixDestroy(&enhanced_pix);
-                }
+    // Bit 0 (DC, the page's mean brightness) stays clear.
+    hash = 0;
+    for (int i = 1; i < 64; ++i) {
+        if (coefficients[i] > median) hash |= (1ULL << i);
+    }
+    return true;
+}
 
-            } catch (const std::exception& ex) {
-                extracted_text = std::string("ERROR: ") + ex.what();
-            } catch (...) {
-                extracted_text = "ERROR: unknown exception";
-            }
+static int hammingDistance(uint64_t a, uint64_t b) {
+    uint64_t bits = a ^ b;
+    int count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        ++count;
+    }
+    return count;
+}
 
-            std::cout << "[Worker " << std::this_thread::get_id() 
-                      << "] Finished processing: " << current_task->file_name
-                      << " (" << extracted_text.size() << " chars)" << std::endl;
+// Bounded FIFO of (profile, hash, text), scanned linearly: a popcount per
+// entry keeps a full scan of 10k entries in the tens of microseconds.
+class NearDuplicateIndex {
+public:
+    NearDuplicateIndex(int max_distance, size_t capacity)
+        : max_distance_(max_distance), capacity_(capacity) {}
 
-            try {
-                current_task->text_promise.set_value(extracted_text);
-            } catch (...) {}
+    bool enabled() const { return max_distance_ >= 0 && capacity_ > 0; }
+
+    bool find(const std::string& profile_name, uint64_t hash, std::string& text, int& distance) {
+        std::shared_lock<std::shared_mutex> guard(mutex_);
+        int best_distance = max_distance_ + 1;
+        const Entry* best = nullptr;
+        for (const Entry& entry : entries_) {
+            if (entry.profile_name != profile_name) continue;
+            int entry_distance = hammingDistance(entry.hash, hash);
+            if (entry_distance < best_distance) {
+                best_distance = entry_distance;
+                best = &entry;
+                if (entry_distance == 0) break;
+            }
         }
+        if (!best) return false;
+        text = best->text;
+        distance = best_distance;
+        return true;
     }
 
-    std::queue<std::shared_ptr<OcrTask>> pending_tasks_;
-    std::mutex queue_mutex_;
-    std::condition_variable task_available_;
-    std::vector<std::thread> workers_;
-    bool shutdown_requested_;
+    void insert(const std::string& profile_name, uint64_t hash, const std::string& text) {
+        std::unique_lock<std::shared_mutex> guard(mutex_);
+        entries_.push_back({profile_name, hash, text});
+        if (entries_.size() > capacity_) entries_.pop_front();
+    }
+
+private:
+    struct Entry {
+        std::string profile_name;
+        uint64_t hash;
+        std::string text;
+    };
+
+    int max_distance_;
+    size_t capacity_;
+    std::shared_mutex mutex_;
+    std::deque<Entry> entries_;
+};
+//----------------------------------------------------------------------------
+
+// JOBS -----------------------------------------------------------------------
+// Results by job id for SubmitImage / GetJobResult, and for ProcessImage
+// callers that lost their connection. Finished entries are evicted oldest
+// first beyond max_finished.
+struct JobRecord {
+    bool finished = false;
+    bool failed = false;
+    std::string text;
+    WordBoxes word_boxes;
+    long long processing_time_ms = 0;
 };
 
-// gRPC Service Implementation ----------------------------------------------------
-class OCRServiceHandler final : public OCRService::Service {
+class JobStore {
 public:
-    OCRServiceHandler(TaskProcessor &processor) : task_processor_(processor) {}
+    JobStore(size_t max_finished, size_t slot_index) : max_finished_(max_finished), next_sequence_(0) {
+        std::ostringstream prefix;
+        prefix << std::hex << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count()
+               << '-' << slot_index << '-';
+        id_prefix_ = prefix.str();
+    }
 
-    Status ProcessImage(ServerContext* context,
-                        const ProcessImageRequest* request,
-                        ProcessImageResponse* response) override {
+    std::string newJobId() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return id_prefix_ + std::to_string(++next_sequence_);
+    }
 
-        std::cout << "[Server] Received request for image: " << request->filename()
-                  << " from client: " << request->client_id() << std::endl;
+    void markPending(const std::string& job_id) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        jobs_[job_id] = JobRecord();
+    }
 
-        auto new_task = std::make_shared<OcrTask>();
-        new_task->file_name = request->filename();
-        new_task->language_code = request->lang();
-        new_task->task_start_time = std::chrono::steady_clock::now();
-        new_task->image_data.assign(request->image().begin(), request->image().end());
+    void markFinished(const std::string& job_id, const std::string& text, bool failed,
+                      long long processing_time_ms, const WordBoxes* word_boxes = nullptr) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        JobRecord& record = jobs_[job_id];
+        if (!record.finished) finished_order_.push_back(job_id);
+        record.finished = true;
+        record.failed = failed;
+        record.text = text;
+        if (word_boxes) record.word_boxes = *word_boxes;
+        record.processing_time_ms = processing_time_ms;
+        while (finished_order_.size() > max_finished_) {
+            jobs_.erase(finished_order_.front());
+            finished_order_.pop_front();
+        }
+    }
 
-        std::future<std::string> text_future = new_task->text_promise.get_future();
-        task_processor_.submitTask(new_task);
+    bool lookup(const std::string& job_id, JobRecord& record) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = jobs_.find(job_id);
+        if (it == jobs_.end()) return false;
+        record = it->second;
+        return true;
+    }
 
-        // FAULT TOLERANCE ---------------------------------------------------------
-        auto status = text_future.wait_for(std::chrono::seconds(120));
-        if (status == std::future_status::timeout) {
-            std::cout << "[Server] Timeout processing image: " << request->filename() << std::endl;
-            response->set_ok(false);
-            response->set_message("Image processing timeout");
-            return Status::OK;
-        }
-        // -------------------------------------------------------------------------
+private:
+    size_t max_finished_;
+    uint64_t next_sequence_;
+    std::string id_prefix_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, JobRecord> jobs_;
+    std::deque<std::string> finished_order_;
+};
+//----------------------------------------------------------------------------
 
-        std::string result_text = text_future.get();
-        response->set_ok(true);
-        response->set_text(result_text);
+// REQUEST CAPTURE ------------------------------------------------------------
+// Records the arrival time and metadata of every ProcessImage/SubmitImage
+// request, plus the image of a sample of them, for ocr_replay (format in
+// request_capture.h). Whether a payload is kept depends only on its content
+// hash, so every copy of an image is kept or none is, and each kept image
+// is written once. Records are flushed but not fsync'ed.
+class RequestCapture {
+public:
+    RequestCapture(const std::string& path, double payload_sample_rate, ProcessStats& stats)
+        : path_(path), payload_sample_rate_(payload_sample_rate), stats_(stats), file_(nullptr),
+          started_(std::chrono::steady_clock::now()) {}
 
-        long long processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - new_task->task_start_time).count();
-        response->set_processing_time_ms(processing_time);
+    ~RequestCapture() {
+        if (file_) std::fclose(file_);
+    }
 
-        std::cout << "[Server] Finished request for image: " << request->filename()
-                  << ", Processing time: " << processing_time << " ms" << std::endl;
+    bool enabled() const { return file_ != nullptr; }
 
-        return Status::OK;
+    bool open() {
+        file_ = std::fopen(path_.c_str(), "wb");
+        if (!file_) return false;
+        started_ = std::chrono::steady_clock::now();
+        const auto wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        writeRecord(file_, kCaptureHeaderRecord, {kCaptureFormat, std::to_string(wall_ms)});
+        std::fflush(file_);
+        return true;
+    }
+
+    void record(const char* rpc, const ProcessImageRequest& request) {
+        if (!file_) return;
+        CapturedRequest captured;
+        captured.offset_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started_).count());
+        captured.rpc = rpc;
+        captured.client_id = request.client_id();
+        captured.batch_id = request.batch_id();
+        captured.filename = request.filename();
+        captured.lang = request.lang();
+        captured.profile = request.profile();
+        captured.form_template = request.form_template();
+        captured.priority = request.priority();
+        captured.want_word_boxes = request.want_word_boxes();
+        captured.payload_hash = contentHash(request.image());
+        captured.payload_size = request.image().size();
+        const bool sampled = static_cast<double>(captured.payload_hash % 1000000) <
+                             payload_sample_rate_ * 1000000.0;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (sampled && written_payloads_.insert(captured.payload_hash).second) {
+            writeRecord(file_, kCapturePayloadRecord, {captureHashText(captured.payload_hash), request.image()});
+            stats_.captured_payload_bytes += captured.payload_size;
+        }
+        writeRecord(file_, kCaptureRequestRecord, captureFields(captured));
+        std::fflush(file_);
+        stats_.captured_requests++;
     }
 
 private:
-    TaskProcessor &task_processor_;
+    std::string path_;
+    double payload_sample_rate_;
+    ProcessStats& stats_;
+    FILE* file_;
+    std::chrono::steady_clock::time_point started_;
+    std::mutex mutex_;
+    std::unordered_set<uint64_t> written_payloads_;
 };
+//----------------------------------------------------------------------------
 
-// Main Function --------------------------------------------------------------
-int main(int argc, char** argv) {
-    size_t worker_threads = 4;
-    if (argc >= 2) {
-        try { worker_threads = std::stoul(argv[1]); }
-        catch (...) { std::cerr << "Invalid worker count, using default 4.\n"; }
+// FORM TEMPLATES -------------------------------------------------------------
+// A template is a reference page plus named field rectangles. Pages are
+// registered against it by comparing ink projection profiles (row and column
+// darkness sums of the page scaled to kProfileWidth px wide), which gives
+// scale from the page width and translation from the best-correlated shift.
+// When both correlations clear kMinAlignmentScore, only the mapped field
+// rectangles are recognized, skipping page layout analysis.
+struct FormFieldRegion {
+    std::string name;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    bool single_line = false;
+};
+
+struct FormTemplate {
+    std::string name;
+    int width = 0;
+    int height = 0;
+    std::vector<float> row_profile;
+    std::vector<float> column_profile;
+    std::vector<FormFieldRegion> fields;
+};
+
+struct TemplateAlignment {
+    double scale = 1.0;
+    int offset_x = 0;
+    int offset_y = 0;
+    double score = 0.0;
+};
+
+static constexpr int kProfileWidth = 256;
+static constexpr int kMaxProfileShift = 24;
+static constexpr double kMinAlignmentScore = 0.6;
+
+static void normalizeProfile(std::vector<float>& profile) {
+    if (profile.empty()) return;
+    double mean = 0.0;
+    for (float value : profile) mean += value;
+    mean /= profile.size();
+    double variance = 0.0;
+    for (float value : profile) variance += (value - mean) * (value - mean);
+    double deviation = std::sqrt(variance / profile.size());
+    for (float& value : profile) {
+        value = deviation > 0.0 ? static_cast<float>((value - mean) / deviation) : 0.0f;
     }
+}
 
-    std::string endpoint = "0.0.0.0:50051";
+static bool projectionProfiles(Pix* gray_pix, std::vector<float>& rows, std::vector<float>& columns) {
+    float scale = static_cast<float>(kProfileWidth) / pixGetWidth(gray_pix);
+    Pix* small_pix = pixScale(gray_pix, scale, scale);
+    if (!small_pix) return false;
 
-    TaskProcessor processor(worker_threads);
-    OCRServiceHandler handler(processor);
+    int width = pixGetWidth(small_pix);
+    int height = pixGetHeight(small_pix);
+    rows.assign(height, 0.0f);
+    columns.assign(width, 0.0f);
+    l_uint32* data = pixGetData(small_pix);
+    int words_per_line = pixGetWpl(small_pix);
+    for (int y = 0; y < height; ++y) {
+        l_uint32* line = data + y * words_per_line;
+        for (int x = 0; x < width; ++x) {
+            float ink = 255.0f - GET_DATA_BYTE(line, x);
+            rows[y] += ink;
+            columns[x] += ink;
+        }
+    }
+    pixDestroy(&small_pix);
+    normalizeProfile(rows);
+    normalizeProfile(columns);
+    return true;
+}
 
-    ServerBuilder builder;
-    builder.AddListeningPort(endpoint, grpc::InsecureServerCredentials());
-    builder.RegisterService(&handler);
+// Shift of `page` against `reference` with the highest mean product over the
+// overlap; both profiles are already zero-mean and unit-variance.
+static int bestProfileShift(const std::vector<float>& reference, const std::vector<float>& page,
+                            double& best_score) {
+    int best_shift = 0;
+    best_score = -1.0;
+    for (int shift = -kMaxProfileShift; shift <= kMaxProfileShift; ++shift) {
+        double sum = 0.0;
+        int overlap = 0;
+        for (int i = 0; i < static_cast<int>(reference.size()); ++i) {
+            int j = i + shift;
+            if (j < 0 || j >= static_cast<int>(page.size())) continue;
+            sum += reference[i] * page[j];
+            ++overlap;
+        }
+        if (overlap < static_cast<int>(reference.size()) / 2) continue;
+        double score = sum / overlap;
+        if (score > best_score) {
+            best_score = score;
+            best_shift = shift;
+        }
+    }
+    return best_shift;
+}
 
-    std::unique_ptr<Server> server(builder.BuildAndStart());
-    std::cout << "OCR Server running at " << endpoint 
-              << " with " << worker_threads << " workers.\n";
+static bool alignToTemplate(const FormTemplate& form, Pix* gray_pix, TemplateAlignment& alignment) {
+    std::vector<float> rows, columns;
+    if (!projectionProfiles(gray_pix, rows, columns)) return false;
 
-    server->Wait();
-    processor.stopProcessing();
-    return 0;
+    double row_score = 0.0, column_score = 0.0;
+    int shift_y = bestProfileShift(form.row_profile, rows, row_score);
+    int shift_x = bestProfileShift(form.column_profile, columns, column_score);
+
+    double page_units = static_cast<double>(pixGetWidth(gray_pix)) / kProfileWidth;
+    alignment.scale = static_cast<double>(pixGetWidth(gray_pix)) / form.width;
+    alignment.offset_x = static_cast<int>(std::lround(shift_x * page_units));
+    alignment.offset_y = static_cast<int>(std::lround(shift_y * page_units));
+    alignment.score = std::min(row_score, column_score);
+    return alignment.score >= kMinAlignmentScore;
+}
+
+// Templates live in memory and in <directory>/<name>.tpl, so a template
+// registered through one prefork process is loaded by the others on first use.
+class TemplateRegistry {
+public:
+    explicit TemplateRegistry(const std::string& directory) : directory_(directory) {}
+
+    static bool validName(const std::string& name) {
+        if (name.empty() || name.size() > 64) return false;
+        return std::all_of(name.begin(), name.end(), [](unsigned char ch) {
+            return std::isalnum(ch) || ch == '_' || ch == '-';
+        });
+    }
+
+    bool add(const FormTemplate& form) {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) return false;
+
+        std::vector<std::string> fields = {
+            form.name, std::to_string(form.width), std::to_string(form.height),
+            joinFloats(form.row_profile), joinFloats(form.column_profile)};
+        for (const FormFieldRegion& region : form.fields) {
+            fields.push_back(region.name);
+            fields.push_back(std::to_string(region.x) + "," + std::to_string(region.y) + "," +
+                             std::to_string(region.width) + "," + std::to_string(region.height) +
+                             "," + (region.single_line ? "1" : "0"));
+        }
+
+        const std::string path = templatePath(form.name);
+        const std::string temporary_path = path + ".tmp";
+        FILE* file = std::fopen(temporary_path.c_str(), "wb");
+        if (!file) return false;
+        writeRecord(file, 'T', fields);
+        std::fclose(file);
+        if (std::rename(temporary_path.c_str(), path.c_str()) != 0) return false;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        templates_[form.name] = {std::make_shared<FormTemplate>(form), fileVersion(path)};
+        return true;
+    }
+
+    // The cached copy is used only while the file is unchanged: prefork
+    // siblings register templates into the same directory.
+    std::shared_ptr<const FormTemplate> find(const std::string& name) {
+        if (!validName(name)) return nullptr;
+        const std::string path = templatePath(name);
+        const FileVersion version = fileVersion(path);
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = templates_.find(name);
+        if (it != templates_.end() && it->second.version == version) return it->second.form;
+        templates_.erase(name);
+
+        std::ifstream input(path, std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        if (!input.is_open() || !readRecord(input, type, fields, 1024) || type != 'T' ||
+            fields.size() < 5 || (fields.size() - 5) % 2 != 0) {
+            return nullptr;
+        }
+        auto form = std::make_shared<FormTemplate>();
+        try {
+            form->name = fields[0];
+            form->width = std::stoi(fields[1]);
+            form->height = std::stoi(fields[2]);
+            form->row_profile = splitFloats(fields[3]);
+            form->column_profile = splitFloats(fields[4]);
+            for (size_t i = 5; i < fields.size(); i += 2) {
+                std::vector<float> values = splitFloats(fields[i + 1]);
+                if (values.size() != 5) continue;
+                form->fields.push_back({fields[i], static_cast<int>(values[0]),
+                                        static_cast<int>(values[1]), static_cast<int>(values[2]),
+                                        static_cast<int>(values[3]), values[4] != 0.0f});
+            }
+        } catch (...) {
+            return nullptr;
+        }
+        templates_[name] = {form, version};
+        return form;
+    }
+
+private:
+    // Modification time and size of a template file; a default value when
+    // it is missing. A re-registration writes a new file, which changes the
+    // time and usually the size.
+    struct FileVersion {
+        std::filesystem::file_time_type modified;
+        uintmax_t size = 0;
+        bool operator==(const FileVersion& other) const {
+            return modified == other.modified && size == other.size;
+        }
+    };
+
+    struct CachedTemplate {
+        std::shared_ptr<FormTemplate> form;
+        FileVersion version;
+    };
+
+    static FileVersion fileVersion(const std::string& path) {
+        FileVersion version;
+        std::error_code error;
+        version.modified = std::filesystem::last_write_time(path, error);
+        if (error) return FileVersion();
+        version.size = std::filesystem::file_size(path, error);
+        if (error) return FileVersion();
+        return version;
+    }
+
+    std::string templatePath(const std::string& name) const { return directory_ + "/" + name + ".tpl"; }
+
+    static std::string joinFloats(const std::vector<float>& values) {
+        std::ostringstream joined;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) joined << ',';
+            joined << values[i];
+        }
+        return joined.str();
+    }
+
+    static std::vector<float> splitFloats(const std::string& joined) {
+        std::vector<float> values;
+        std::stringstream stream(joined);
+        std::string item;
+        while (std::getline(stream, item, ',')) values.push_back(std::stof(item));
+        return values;
+    }
+
+    std::string directory_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, CachedTemplate> templates_;
+};
+//----------------------------------------------------------------------------
+
+// MEMORY ---------------------------------------------------------------------
+static size_t currentResidentBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<size_t>(info.resident_size);
+#else
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0, resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) return 0;
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// A worker replaces its engines after max_tasks recognitions or once the
+// process RSS has grown by max_growth_bytes since the worker's engines were
+// built. Growth rather than absolute RSS, so memory the worker does not own
+// (caches, other workers, the allocator keeping freed pages) cannot make it
+// rebuild after every task. Zero disables either limit.
+struct EngineRecyclePolicy {
+    static constexpr size_t kMinTasksBetweenRecycles = 8;
+    size_t max_tasks = 0;
+    size_t max_growth_bytes = 0;
+};
+
+// Keyed by profile name, "profile@lang" for engines created on demand for a
+// detected script, and kOsdEngineKey for the orientation/script detector.
+using EngineSet = std::map<std::string, std::unique_ptr<tesseract::TessBaseAPI>>;
+
+struct WorkerEngineState {
+    std::unique_ptr<EngineSet> engines;
+    std::set<std::string> unavailable_engines;
+    std::future<std::unique_ptr<EngineSet>> replacement;
+    size_t tasks_since_init = 0;
+    size_t resident_at_init = 0;
+};
+//----------------------------------------------------------------------------
+
+// WORD BOXES -----------------------------------------------------------------
+// Walks the words of the last recognition (GetIterator does not recognize
+// again) into parallel packed arrays: x, y, width, height per word in
+// `boxes`, confidence in whole percent, and byte start/length of the word in
+// the GetUTF8Text output in `text_spans`.
+static void collectWordBoxes(tesseract::TessBaseAPI& engine, const std::string& text,
+                             WordBoxes& word_boxes) {
+    std::unique_ptr<tesseract::ResultIterator> iterator(engine.GetIterator());
+    if (!iterator) return;
+
+    size_t search_from = 0;
+    do {
+        if (iterator->Empty(tesseract::RIL_WORD)) continue;
+        std::unique_ptr<char[]> word(iterator->GetUTF8Text(tesseract::RIL_WORD));
+        int left = 0, top = 0, right = 0, bottom = 0;
+        if (!word || !iterator->BoundingBox(tesseract::RIL_WORD, &left, &top, &right, &bottom)) {
+            continue;
+        }
+
+        size_t word_length = std::strlen(word.get());
+        size_t offset = text.find(word.get(), search_from);
+        if (offset == std::string::npos) {
+            offset = search_from;
+            word_length = 0;
+        } else {
+            search_from = offset + word_length;
+        }
+
+        word_boxes.add_boxes(left);
+        word_boxes.add_boxes(top);
+        word_boxes.add_boxes(right - left);
+        word_boxes.add_boxes(bottom - top);
+        word_boxes.add_confidences(static_cast<uint32_t>(
+            std::lround(std::max(0.0f, iterator->Confidence(tesseract::RIL_WORD)))));
+        word_boxes.add_text_spans(static_cast<uint32_t>(offset));
+        word_boxes.add_text_spans(static_cast<uint32_t>(word_length));
+    } while (iterator->Next(tesseract::RIL_WORD));
+}
+//----------------------------------------------------------------------------
+
+// SCRIPT DETECTION -----------------------------------------------------------
+// With OSD enabled, each page first goes through Tesseract's orientation and
+// script detector on a downscaled copy. The page is turned upright and the
+// detected script picks a single-language engine instead of the profile's
+// (possibly multi-language) one. Pages of the same client batch reuse the
+// first confident detection and skip the OSD pass.
+struct OsdOptions {
+    bool enabled = false;
+    std::map<std::string, std::string> script_languages;
+};
+
+struct ScriptDetection {
+    std::string script;
+    int rotation_degrees = 0;
+};
+
+static constexpr const char* kOsdEngineKey = "@osd";
+static constexpr int kOsdMaxDimension = 1024;
+static constexpr float kMinScriptConfidence = 1.0f;
+static constexpr float kMinOrientationConfidence = 1.0f;
+static constexpr size_t kMaxBatchDetections = 4096;
+//----------------------------------------------------------------------------
+
+// FAULT INJECTION ------------------------------------------------------------
+// Test-only degradation of the worker pipeline. A rule has the form
+// stage:action[=value][@probability], for example "recognize:slow=10@0.2".
+//   stages:  dequeue, decode, recognize, complete
+//   actions: delay=MS, slow=FACTOR (stretches the stage), fail, hang (blocks
+//            the worker until the rules are replaced or the server stops)
+// Rules are per process; with no rules the checks are a single atomic load.
+struct FaultRule {
+    enum class Action { Delay, Slow, Fail, Hang };
+    std::string stage;
+    Action action = Action::Delay;
+    double value = 0.0;
+    double probability = 1.0;
+    std::string spec;
+};
+
+class FaultInjector {
+public:
+    FaultInjector() : random_(std::random_device{}()) {}
+
+    static bool parseRule(const std::string& spec, FaultRule& rule, std::string& error) {
+        static const std::set<std::string> stages = {"dequeue", "decode", "recognize", "complete"};
+        rule = FaultRule();
+        rule.spec = spec;
+
+        std::string body = spec;
+        size_t at = body.find('@');
+        try {
+            if (at != std::string::npos) {
+                rule.probability = std::stod(body.substr(at + 1));
+                body.resize(at);
+            }
+            size_t colon = body.find(':');
+            if (colon == std::string::npos) {
+                error = "Fault rule needs stage:action: " + spec;
+                return false;
+            }
+            rule.stage = body.substr(0, colon);
+            std::string action = body.substr(colon + 1);
+            size_t equals = action.find('=');
+            if (equals != std::string::npos) {
+                rule.value = std::stod(action.substr(equals + 1));
+                action.resize(equals);
+            }
+            if (action == "delay") rule.action = FaultRule::Action::Delay;
+            else if (action == "slow") rule.action = FaultRule::Action::Slow;
+            else if (action == "fail") rule.action = FaultRule::Action::Fail;
+            else if (action == "hang") rule.action = FaultRule::Action::Hang;
+            else {
+                error = "Unknown fault action: " + spec;
+                return false;
+            }
+        } catch (const std::exception&) {
+            error = "Malformed fault rule: " + spec;
+            return false;
+        }
+        if (!stages.count(rule.stage)) {
+            error = "Unknown fault stage: " + spec;
+            return false;
+        }
+        if (rule.probability < 0.0 || rule.probability > 1.0 || rule.value < 0.0) {
+            error = "Fault probability must be in [0, 1] and values non-negative: " + spec;
+            return false;
+        }
+        return true;
+    }
+
+    // Replaces every rule; an empty list disarms injection. Workers hanging
+    // under the old rules are released.
+    bool setRules(const std::vector<std::string>& specs, std::string& error) {
+        std::vector<FaultRule> rules;
+        for (const std::string& spec : specs) {
+            FaultRule rule;
+            if (!parseRule(spec, rule, error)) return false;
+            rules.push_back(rule);
+        }
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            rules_ = std::move(rules);
+            ++generation_;
+            armed_ = !rules_.empty();
+        }
+        released_.notify_all();
+        return true;
+    }
+
+    std::vector<std::string> activeRules() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::vector<std::string> specs;
+        for (const FaultRule& rule : rules_) specs.push_back(rule.spec);
+        return specs;
+    }
+
+    // Applies delay and hang rules for the stage being entered. Returns true
+    // when the stage should fail.
+    bool inject(const std::string& stage, ProcessStats& stats) {
+        if (!armed_) return false;
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool fail = false;
+        double delay_ms = 0.0;
+        bool hang = false;
+        for (const FaultRule& rule : rules_) {
+            if (rule.stage != stage || rule.action == FaultRule::Action::Slow || !roll(rule)) continue;
+            stats.faults_injected++;
+            if (rule.action == FaultRule::Action::Fail) fail = true;
+            else if (rule.action == FaultRule::Action::Hang) hang = true;
+            else delay_ms += rule.value;
+        }
+        if (hang) {
+            std::cout << "[Fault] Worker " << std::this_thread::get_id()
+                      << " hanging at " << stage << std::endl;
+            uint64_t generation = generation_;
+            released_.wait(lock, [&] { return stopped_ || generation_ != generation; });
+        }
+        lock.unlock();
+        if (delay_ms > 0.0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<long long>(delay_ms)));
+        }
+        return fail;
+    }
+
+    // Applies slow rules when leaving a stage by sleeping (factor - 1) times
+    // the time the stage took.
+    void stretch(const std::string& stage, std::chrono::steady_clock::time_point stage_start,
+                 ProcessStats& stats) {
+        if (!armed_) return;
+        double factor = 1.0;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            for (const FaultRule& rule : rules_) {
+                if (rule.stage != stage || rule.action != FaultRule::Action::Slow || !roll(rule)) continue;
+                stats.faults_injected++;
+                factor = std::max(factor, rule.value);
+            }
+        }
+        if (factor <= 1.0) return;
+        auto elapsed = std::chrono::steady_clock::now() - stage_start;
+        std::this_thread::sleep_for(std::chrono::duration_cast<std::chrono::milliseconds>(
+            elapsed * (factor - 1.0)));
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stopped_ = true;
+        }
+        released_.notify_all();
+    }
+
+private:
+    bool roll(const FaultRule& rule) {
+        return rule.probability >= 1.0 ||
+               std::uniform_real_distribution<double>(0.0, 1.0)(random_) < rule.probability;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable released_;
+    std::vector<FaultRule> rules_;
+    uint64_t generation_ = 0;
+    bool stopped_ = false;
+    std::atomic<bool> armed_{false};
+    std::mt19937_64 random_;
+};
+//----------------------------------------------------------------------------
+
+// PAGE TILES -----------------------------------------------------------------
+// With the tile cache on, pages are cut into full-width bands at runs of
+// blank rows (paragraph and block gaps), so an edit changes only the bands it
+// touches. A band's key hashes its binarized ink trimmed to the ink bounds,
+// which stays the same when an insertion above only shifts it down.
+struct PageTile {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    uint64_t hash = 0;
+};
+
+static constexpr int kTileInkThreshold = 128;
+static constexpr int kTileMinGapRows = 8;
+static constexpr int kTilePadding = 4;
+
+// Accepts the 8 bpp page or the 1 bpp output of sauvolaBinarize.
+static std::vector<PageTile> layoutTiles(Pix* page_pix) {
+    const int width = pixGetWidth(page_pix);
+    const int height = pixGetHeight(page_pix);
+    const int min_gap = std::max(kTileMinGapRows, height / 150);
+    l_uint32* data = pixGetData(page_pix);
+    const int words_per_line = pixGetWpl(page_pix);
+    const bool binary = pixGetDepth(page_pix) == 1;
+    auto is_ink = [binary](l_uint32* line, int x) {
+        return binary ? GET_DATA_BIT(line, x) != 0 : GET_DATA_BYTE(line, x) < kTileInkThreshold;
+    };
+
+    std::vector<int> row_left(height, -1), row_right(height, -1);
+    for (int y = 0; y < height; ++y) {
+        l_uint32* line = data + y * words_per_line;
+        for (int x = 0; x < width; ++x) {
+            if (!is_ink(line, x)) continue;
+            if (row_left[y] < 0) row_left[y] = x;
+            row_right[y] = x;
+        }
+    }
+
+    std::vector<PageTile> tiles;
+    for (int y = 0; y < height;) {
+        if (row_left[y] < 0) { ++y; continue; }
+        PageTile tile;
+        int left = width, right = 0, top = y, bottom = y, blank = 0;
+        for (; y < height && blank < min_gap; ++y) {
+            if (row_left[y] < 0) { ++blank; continue; }
+            blank = 0;
+            bottom = y;
+            left = std::min(left, row_left[y]);
+            right = std::max(right, row_right[y]);
+        }
+
+        std::vector<uint8_t> bits;
+        bits.reserve(static_cast<size_t>(right - left + 8) / 8 * (bottom - top + 1));
+        for (int row = top; row <= bottom; ++row) {
+            l_uint32* line = data + row * words_per_line;
+            uint8_t packed = 0;
+            for (int x = left; x <= right; ++x) {
+                packed = static_cast<uint8_t>((packed << 1) | is_ink(line, x));
+                if ((x - left) % 8 == 7) { bits.push_back(packed); packed = 0; }
+            }
+            bits.push_back(packed);
+        }
+        tile.hash = contentHash(bits.data(), bits.size(),
+                                (static_cast<uint64_t>(right - left) << 32) | static_cast<uint64_t>(bottom - top));
+
+        tile.x = std::max(0, left - kTilePadding);
+        tile.y = std::max(0, top - kTilePadding);
+        tile.width = std::min(width, right + kTilePadding + 1) - tile.x;
+        tile.height = std::min(height, bottom + kTilePadding + 1) - tile.y;
+        tiles.push_back(tile);
+    }
+    return tiles;
+}
+//----------------------------------------------------------------------------
+
+// PARALLEL PREPROCESSING -----------------------------------------------------
+// Pages above the configured size are converted and thresholded in
+// horizontal strips on short-lived threads, each writing its own rows of one
+// output Pix. Standard parallel algorithms are not available with Apple
+// clang, so strips run on std::async.
+static constexpr int kMinStripRows = 256;
+
+static size_t stripCountFor(Pix* pix, double min_megapixels, size_t max_strips) {
+    if (min_megapixels <= 0.0 || max_strips <= 1) return 1;
+    double megapixels = static_cast<double>(pixGetWidth(pix)) * pixGetHeight(pix) / 1e6;
+    if (megapixels < min_megapixels) return 1;
+    return std::max<size_t>(1, std::min<size_t>(max_strips, pixGetHeight(pix) / kMinStripRows));
+}
+
+// Every worker of every process may split a page at once, so each gets its
+// share of the cores rather than all of them.
+static size_t stripBudget(size_t workers_per_process, size_t processes) {
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, cores / std::max<size_t>(1, workers_per_process * processes));
+}
+
+// Calls fn(first_row, end_row) for `strips` row ranges, the last one on the
+// calling thread.
+static void forEachStrip(int height, size_t strips, const std::function<void(int, int)>& fn) {
+    if (strips <= 1) {
+        fn(0, height);
+        return;
+    }
+    std::vector<std::future<void>> running;
+    const int rows = static_cast<int>((height + strips - 1) / strips);
+    for (int first = 0; first < height; first += rows) {
+        const int end = std::min(height, first + rows);
+        if (end == height) fn(first, end);
+        else running.push_back(std::async(std::launch::async, fn, first, end));
+    }
+    for (auto& strip : running) strip.get();
+}
+
+// 8 bpp gray and 32 bpp RGB are converted here (RGB with Leptonica's
+// luminance weights); any other depth or a colormap goes to pixConvertTo8.
+static Pix* convertTo8Strips(Pix* pix, size_t strips) {
+    const int depth = pixGetDepth(pix);
+    if (strips <= 1 || (depth != 8 && depth != 32) || pixGetColormap(pix)) return pixConvertTo8(pix, 0);
+    if (depth == 8) return pixClone(pix);
+
+    const int width = pixGetWidth(pix);
+    Pix* gray_pix = pixCreate(width, pixGetHeight(pix), 8);
+    if (!gray_pix) return nullptr;
+    pixCopyResolution(gray_pix, pix);
+    l_uint32* source = pixGetData(pix);
+    const int source_wpl = pixGetWpl(pix);
+    l_uint32* target = pixGetData(gray_pix);
+    const int target_wpl = pixGetWpl(gray_pix);
+    forEachStrip(pixGetHeight(pix), strips, [&](int first, int end) {
+        for (int y = first; y < end; ++y) {
+            const l_uint32* in = source + y * source_wpl;
+            l_uint32* out = target + y * target_wpl;
+            for (int x = 0; x < width; ++x) {
+                l_uint32 pixel = in[x];
+                int luminance = static_cast<int>(0.3f * (pixel >> 24) + 0.5f * ((pixel >> 16) & 0xff) +
+                                                 0.2f * ((pixel >> 8) & 0xff) + 0.5f);
+                SET_DATA_BYTE(out, x, std::min(255, luminance));
+            }
+        }
+    });
+    return gray_pix;
+}
+
+// The same tone curve as pixGammaTRC, applied through a lookup table.
+static Pix* gammaTRCStrips(Pix* gray_pix, float gamma, int min_value, int max_value, size_t strips) {
+    if (strips <= 1) return pixGammaTRC(nullptr, gray_pix, gamma, min_value, max_value);
+
+    uint8_t curve[256];
+    for (int value = 0; value < 256; ++value) {
+        if (value <= min_value) { curve[value] = 0; continue; }
+        if (value >= max_value) { curve[value] = 255; continue; }
+        float x = static_cast<float>(value - min_value) / (max_value - min_value);
+        curve[value] = static_cast<uint8_t>(std::min(255.0f, 255.0f * std::pow(x, 1.0f / gamma) + 0.5f));
+    }
+
+    const int width = pixGetWidth(gray_pix);
+    Pix* mapped_pix = pixCreate(width, pixGetHeight(gray_pix), 8);
+    if (!mapped_pix) return nullptr;
+    pixCopyResolution(mapped_pix, gray_pix);
+    l_uint32* source = pixGetData(gray_pix);
+    l_uint32* target = pixGetData(mapped_pix);
+    const int wpl = pixGetWpl(gray_pix);
+    forEachStrip(pixGetHeight(gray_pix), strips, [&](int first, int end) {
+        // Byte order within a word does not matter for a per-byte table.
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(source + first * wpl);
+        uint8_t* out = reinterpret_cast<uint8_t*>(target + first * wpl);
+        const size_t bytes = static_cast<size_t>(end - first) * wpl * 4;
+        for (size_t i = 0; i < bytes; ++i) out[i] = curve[in[i]];
+    });
+    return mapped_pix;
+}
+//----------------------------------------------------------------------------
+
+// BINARIZATION ---------------------------------------------------------------
+// Sauvola local thresholding: a pixel is ink when it is darker than
+//   T = m * (1 + k * (s / 128 - 1))
+// where m and s are the mean and standard deviation of a window x window
+// neighbourhood. Window sums come from per-column sums over the window rows,
+// updated as the window slides down, and a prefix sum (1-D integral image)
+// of those along each row, so the cost per pixel is constant in the window
+// size. The column and threshold loops run over plain contiguous arrays so
+// the compiler vectorizes them (SSE2/AVX on x86, NEON on ARM).
+//
+// The result is a 1 bpp Pix; given one, Tesseract skips its own thresholding.
+// Strips are independent: each starts its column sums from its own halo rows.
+static Pix* sauvolaBinarize(Pix* gray_pix, int window, float k, size_t strips = 1) {
+    const int width = pixGetWidth(gray_pix);
+    const int height = pixGetHeight(gray_pix);
+    const int half = std::max(1, window / 2);
+    Pix* binary_pix = pixCreate(width, height, 1);
+    if (!binary_pix) return nullptr;
+    pixCopyResolution(binary_pix, gray_pix);
+
+    l_uint32* gray_data = pixGetData(gray_pix);
+    const int gray_wpl = pixGetWpl(gray_pix);
+    l_uint32* binary_data = pixGetData(binary_pix);
+    const int binary_wpl = pixGetWpl(binary_pix);
+
+    // Rows unpacked to bytes once, independent of Leptonica's byte order.
+    std::vector<uint8_t> gray(static_cast<size_t>(width) * height);
+    forEachStrip(height, strips, [&](int first, int end) {
+        for (int y = first; y < end; ++y) {
+            l_uint32* line = gray_data + y * gray_wpl;
+            uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x) row[x] = static_cast<uint8_t>(GET_DATA_BYTE(line, x));
+        }
+    });
+
+    const float inverse_range = 1.0f / 128.0f;
+    forEachStrip(height, strips, [&](int first, int end) {
+        std::vector<uint32_t> column_sum(width, 0), column_squares(width, 0);
+        std::vector<uint64_t> prefix_sum(width + 1, 0), prefix_squares(width + 1, 0);
+        std::vector<float> mean(width), deviation(width), count(width);
+        auto add_row = [&](int y, int sign) {
+            const uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x) {
+                uint32_t value = row[x];
+                column_sum[x] += sign * value;
+                column_squares[x] += sign * value * value;
+            }
+        };
+        for (int y = std::max(0, first - half - 1); y < std::min(height, first + half); ++y) add_row(y, 1);
+
+        for (int y = first; y < end; ++y) {
+            if (y + half < height) add_row(y + half, 1);
+            if (y - half - 1 >= 0) add_row(y - half - 1, -1);
+            const int rows = std::min(height - 1, y + half) - std::max(0, y - half) + 1;
+
+            for (int x = 0; x < width; ++x) {
+                prefix_sum[x + 1] = prefix_sum[x] + column_sum[x];
+                prefix_squares[x + 1] = prefix_squares[x] + column_squares[x];
+            }
+            for (int x = 0; x < width; ++x) {
+                const int left = std::max(0, x - half);
+                const int right = std::min(width - 1, x + half);
+                count[x] = static_cast<float>((right - left + 1) * rows);
+                mean[x] = static_cast<float>(prefix_sum[right + 1] - prefix_sum[left]);
+                deviation[x] = static_cast<float>(prefix_squares[right + 1] - prefix_squares[left]);
+            }
+            for (int x = 0; x < width; ++x) {
+                float m = mean[x] / count[x];
+                float variance = deviation[x] / count[x] - m * m;
+                float s = std::sqrt(variance > 0.0f ? variance : 0.0f);
+                mean[x] = m * (1.0f + k * (s * inverse_range - 1.0f));
+            }
+
+            const uint8_t* row = gray.data() + static_cast<size_t>(y) * width;
+            l_uint32* line = binary_data + y * binary_wpl;
+            for (int word = 0; word * 32 < width; ++word) {
+                l_uint32 bits = 0;
+                const int word_end = std::min(width, word * 32 + 32);
+                for (int x = word * 32; x < word_end; ++x) {
+                    bits |= static_cast<l_uint32>(row[x] < mean[x]) << (31 - (x & 31));
+                }
+                line[word] = bits;
+            }
+        }
+    });
+    return binary_pix;
+}
+//----------------------------------------------------------------------------
+
+// COST MODEL -----------------------------------------------------------------
+// Online regression of worker time per task. Each profile/language pair has
+// its own recursive least squares fit over
+//   [1, megapixels, megapixels * depth / 8, megapixels * ink density],
+// with a forgetting factor so the fit follows engine recycles and load
+// changes. Pairs with few samples fall back to the fit over all tasks, and
+// that to a fixed per-megapixel rate.
+class CostModel {
+public:
+    static constexpr size_t kFeatures = 4;
+    static constexpr size_t kMinSamples = 5;
+    static constexpr size_t kMaxKeys = 256;
+    static constexpr double kForgetting = 0.995;
+    static constexpr double kDefaultMsPerMegapixel = 300.0;
+    static constexpr double kDefaultBaseMs = 50.0;
+
+    static CostFeatures featuresFromHeader(const std::vector<unsigned char>& image_data) {
+        CostFeatures features;
+        l_int32 format = 0, width = 0, height = 0, bits = 0, samples = 0, colormap = 0;
+        if (!image_data.empty() &&
+            pixReadHeaderMem(image_data.data(), image_data.size(), &format, &width, &height,
+                             &bits, &samples, &colormap) == 0 && width > 0 && height > 0) {
+            features.megapixels = static_cast<double>(width) * height / 1e6;
+            features.depth_bits = std::max(1, bits * std::max(1, samples));
+        } else {
+            // Unreadable headers are costed at a rough 8 pixels per byte.
+            features.megapixels = image_data.size() * 8.0 / 1e6;
+        }
+        return features;
+    }
+
+    // Share of dark pixels on a sparse grid of the 8 bpp page.
+    static double inkDensity(Pix* gray_pix) {
+        const int width = pixGetWidth(gray_pix);
+        const int height = pixGetHeight(gray_pix);
+        l_uint32* data = pixGetData(gray_pix);
+        const int words_per_line = pixGetWpl(gray_pix);
+        size_t samples = 0, ink = 0;
+        for (int y = 0; y < height; y += 4) {
+            l_uint32* line = data + y * words_per_line;
+            for (int x = 0; x < width; x += 4) {
+                ink += GET_DATA_BYTE(line, x) < 128;
+                ++samples;
+            }
+        }
+        return samples ? static_cast<double>(ink) / samples : 0.0;
+    }
+
+    double predict(const std::string& key, const CostFeatures& features) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        const Fit* fit = usableFit(key);
+        if (!fit) return kDefaultBaseMs + kDefaultMsPerMegapixel * features.megapixels;
+        CostFeatures completed = features;
+        if (completed.ink_density < 0.0) completed.ink_density = fit->mean_ink;
+        return std::max(1.0, fit->evaluate(completed));
+    }
+
+    void update(const std::string& key, const CostFeatures& features, double actual_ms) {
+        if (features.ink_density < 0.0) return;
+        std::lock_guard<std::mutex> guard(mutex_);
+        global_.update(features, actual_ms);
+        auto it = fits_.find(key);
+        if (it == fits_.end()) {
+            if (fits_.size() >= kMaxKeys) return;
+            it = fits_.emplace(key, Fit()).first;
+        }
+        it->second.update(features, actual_ms);
+    }
+
+private:
+    struct Fit {
+        std::array<double, kFeatures> weights{};
+        std::array<std::array<double, kFeatures>, kFeatures> covariance{};
+        size_t samples = 0;
+        double mean_ink = 0.0;
+
+        Fit() {
+            for (size_t i = 0; i < kFeatures; ++i) covariance[i][i] = 1e4;
+        }
+
+        static std::array<double, kFeatures> vector(const CostFeatures& features) {
+            return {1.0, features.megapixels, features.megapixels * features.depth_bits / 8.0,
+                    features.megapixels * features.ink_density};
+        }
+
+        double evaluate(const CostFeatures& features) const {
+            auto x = vector(features);
+            double y = 0.0;
+            for (size_t i = 0; i < kFeatures; ++i) y += weights[i] * x[i];
+            return y;
+        }
+
+        void update(const CostFeatures& features, double actual_ms) {
+            auto x = vector(features);
+            std::array<double, kFeatures> px{};
+            double denominator = kForgetting;
+            for (size_t i = 0; i < kFeatures; ++i) {
+                for (size_t j = 0; j < kFeatures; ++j) px[i] += covariance[i][j] * x[j];
+                denominator += x[i] * px[i];
+            }
+            double error = actual_ms - evaluate(features);
+            for (size_t i = 0; i < kFeatures; ++i) weights[i] += px[i] / denominator * error;
+            for (size_t i = 0; i < kFeatures; ++i) {
+                for (size_t j = 0; j < kFeatures; ++j) {
+                    covariance[i][j] = (covariance[i][j] - px[i] * px[j] / denominator) / kForgetting;
+                }
+                // Directions the inputs never excite would otherwise grow
+                // without bound under forgetting.
+                covariance[i][i] = std::min(covariance[i][i], 1e6);
+            }
+            ++samples;
+            mean_ink += (features.ink_density - mean_ink) / std::min<size_t>(samples, 100);
+        }
+    };
+
+    const Fit* usableFit(const std::string& key) const {
+        auto it = fits_.find(key);
+        if (it != fits_.end() && it->second.samples >= kMinSamples) return &it->second;
+        return global_.samples >= kMinSamples ? &global_ : nullptr;
+    }
+
+    std::mutex mutex_;
+    Fit global_;
+    std::unordered_map<std::string, Fit> fits_;
+};
+//----------------------------------------------------------------------------
+
+// MULTITHREADING -----------------------------------------------------------
+// FIFO by default. With shortest_first, workers take the queued task with
+// the lowest predicted cost, less one second of predicted work per aging
+// interval it has waited, so large pages still reach a worker under load.
+// With max_eta set, tasks whose predicted completion is further out than
+// that are refused at admission.
+//
+// Tasks are in an interactive or a bulk lane. Interactive tasks are always
+// taken first; the first reserved_interactive workers take nothing else, so
+// they are free for interactive work however deep the bulk backlog is. The
+// other workers serve both lanes. Shadow copies wait in a third lane of
+// their own, taken only when both others are empty and never counted in the
+// queue length or the admission ETA.
+struct SchedulingPolicy {
+    bool shortest_first = false;
+    std::chrono::milliseconds aging{500};
+    std::chrono::milliseconds max_eta{0};
+    size_t reserved_interactive = 0;
+    // Pages of at least this many megapixels are preprocessed in parallel
+    // strips, at most max_strips per page; 0 keeps every page on the
+    // worker's own thread.
+    double parallel_preprocess_mp = 0.0;
+    size_t max_strips = 1;
+    // How long a task lent to a peer stays the peer's to complete.
+    std::chrono::seconds loan_lease{30};
+};
+
+class TaskProcessor {
+public:
+    TaskProcessor(size_t worker_count, const std::string& tessdata_path,
+                  const ProfileCatalog& profiles, const EngineRecyclePolicy& recycle_policy,
+                  const OsdOptions& osd, TemplateRegistry& templates, FaultInjector& faults,
+                  ResultCache& tile_cache, const SchedulingPolicy& scheduling,
+                  const ImageLimits& image_limits, ProcessStats& stats)
+        : tessdata_path_(tessdata_path), profiles_(profiles),
+          recycle_policy_(recycle_policy), osd_(osd), templates_(templates), faults_(faults),
+          tile_cache_(tile_cache), scheduling_(scheduling), image_limits_(image_limits), stats_(stats),
+          recycle_in_flight_(false), next_task_id_(1), busy_workers_(0),
+          warming_workers_(worker_count), ready_workers_(0), shutdown_requested_(false) {
+        stats_.worker_count = static_cast<int32_t>(worker_count);
+        stats_.workers_ready = 0;
+        stats_.workers_failed = 0;
+        // At least one worker always serves the bulk lane.
+        scheduling_.reserved_interactive = std::min(scheduling_.reserved_interactive,
+                                                    worker_count > 0 ? worker_count - 1 : 0);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers_.emplace_back(&TaskProcessor::processTasks, this,
+                                  i < scheduling_.reserved_interactive);
+        }
+    }
+
+    ~TaskProcessor() {
+        stopProcessing();
+    }
+//----------------------------------------------------------------------------
+
+// SYNCHRONIZATION -----------------------------------------------------------
+    void submitTask(std::shared_ptr<OcrTask> task) {
+        if (task->predicted_ms < 0.0) predictCost(*task);
+        bool wake_all = false;
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            wake_all = !everyWorkerRuns(*task);
+            task->task_id = next_task_id_++;
+            if (task->shadow) {
+                task->interactive = false;
+                shadow_tasks_.push_back(task);
+            } else {
+                pending_tasks_.push_back(task);
+                if (task->interactive) pending_interactive_++;
+                stats_.tasks_submitted++;
+                updateQueueStats();
+            }
+            std::cout << "[Queue] " << (task->shadow ? "Shadow task" : "Task") << " submitted: "
+                      << task->file_name << ", Pending tasks: " << pending_tasks_.size() << std::endl;
+        }
+        if (wake_all) {
+            task_available_.notify_all();
+            if (task->interactive) interactive_available_.notify_all();
+        } else {
+            task_available_.notify_one();
+            if (task->interactive) interactive_available_.notify_one();
+        }
+    }
+
+    // Predicts the task's own worker time and returns the expected time until
+    // it completes, assuming the queued and running work spreads evenly over
+    // the workers. Sets `admitted` to false when that exceeds max_eta.
+    long long estimateCompletion(OcrTask& task, bool& admitted) {
+        predictCost(task);
+        double backlog_ms = 0.0;
+        // Bulk work never delays an interactive task beyond what is already
+        // running; bulk tasks only get the unreserved workers.
+        size_t serving_workers = 0;
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            serving_workers = task.interactive || ready_workers_ <= scheduling_.reserved_interactive
+                ? ready_workers_ : ready_workers_ - scheduling_.reserved_interactive;
+            for (const auto& queued : pending_tasks_) {
+                if (queued->interactive || !task.interactive) {
+                    backlog_ms += std::max(0.0, queued->predicted_ms);
+                }
+            }
+            auto now = std::chrono::steady_clock::now();
+            for (const auto& entry : running_predictions_) {
+                double elapsed_ms = std::chrono::duration<double, std::milli>(now - entry.second.second).count();
+                backlog_ms += std::max(0.0, entry.second.first - elapsed_ms);
+            }
+        }
+        long long eta_ms = static_cast<long long>(backlog_ms / std::max<size_t>(1, serving_workers)
+                                                  + task.predicted_ms);
+        admitted = scheduling_.max_eta.count() == 0 || eta_ms <= scheduling_.max_eta.count();
+        if (!admitted) stats_.tasks_rejected++;
+        return eta_ms;
+    }
+
+    // Called for every finished task before its promise is fulfilled. Must be
+    // set before the first submitTask.
+    void setCompletionListener(std::function<void(const OcrTask&, const std::string&)> listener) {
+        completion_listener_ = std::move(listener);
+    }
+
+    // Ready workers not needed by running or queued real tasks.
+    size_t idleWorkerCount() {
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        size_t busy = busy_workers_ + pending_tasks_.size();
+        return busy >= ready_workers_ ? 0 : ready_workers_ - busy;
+    }
+
+    size_t queuedShadowTasks() {
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        return shadow_tasks_.size();
+    }
+
+    // Blocks until every worker has finished warming up, or for at most
+    // `timeout`. True once warm-up is over.
+    bool waitForWarmUp(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        return readiness_changed_.wait_for(lock, timeout, [&] { return warming_workers_ == 0; });
+    }
+
+    size_t readyWorkerCount() {
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        return ready_workers_;
+    }
+
+    enum class ProfileReadiness { Ready, WarmingUp, Unavailable };
+
+    // Ready as soon as one worker has a warm engine for the profile;
+    // unavailable once warm-up is over and none has.
+    ProfileReadiness profileReadiness(const std::string& profile_name) {
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        auto it = profile_workers_.find(profile_name);
+        if (it != profile_workers_.end() && it->second > 0) return ProfileReadiness::Ready;
+        return warming_workers_ > 0 ? ProfileReadiness::WarmingUp : ProfileReadiness::Unavailable;
+    }
+
+    // Hands up to max_tasks queued tasks to a peer, newest first, while
+    // keeping at least one queued task per local worker. Donated tasks stay
+    // on loan to that thief until it reports a result or the lease expires.
+    std::vector<std::shared_ptr<OcrTask>> donateTasks(size_t max_tasks, const std::string& thief) {
+        std::vector<std::shared_ptr<OcrTask>> donated;
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        auto expires_at = std::chrono::steady_clock::now() + scheduling_.loan_lease;
+        for (auto it = pending_tasks_.end(); it != pending_tasks_.begin() &&
+             donated.size() < max_tasks && pending_tasks_.size() > ready_workers_;) {
+            --it;
+            if ((*it)->on_complete || (*it)->shadow || (*it)->keep_orientation ||
+                !(*it)->form_template.empty()) {
+                continue;
+            }
+            donated.push_back(*it);
+            loaned_tasks_[(*it)->task_id] = {*it, thief, expires_at};
+            if ((*it)->interactive) pending_interactive_--;
+            it = pending_tasks_.erase(it);
+        }
+        stats_.tasks_donated += donated.size();
+        updateQueueStats();
+        return donated;
+    }
+
+    // Only the thief holding an unexpired lease may complete a loan; a late
+    // or foreign result is refused and the task runs (or ran) locally.
+    bool completeLoanedTask(uint64_t task_id, const std::string& thief, const std::string& text,
+                            bool failed, const WordBoxes& word_boxes) {
+        std::shared_ptr<OcrTask> task;
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            auto it = loaned_tasks_.find(task_id);
+            if (it == loaned_tasks_.end() || it->second.thief != thief ||
+                std::chrono::steady_clock::now() >= it->second.expires_at) {
+                return false;
+            }
+            task = it->second.task;
+            loaned_tasks_.erase(it);
+        }
+        task->word_boxes = word_boxes;
+        finishTask(task, text, failed);
+        return true;
+    }
+
+    // Puts loans the peer never answered back at the front of the queue.
+    void requeueExpiredLoans() {
+        size_t requeued = 0;
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            auto now = std::chrono::steady_clock::now();
+            for (auto it = loaned_tasks_.begin(); it != loaned_tasks_.end();) {
+                if (now < it->second.expires_at) { ++it; continue; }
+                std::cout << "[Queue] Loan expired, requeueing: "
+                          << it->second.task->file_name << std::endl;
+                pending_tasks_.push_front(it->second.task);
+                if (it->second.task->interactive) pending_interactive_++;
+                it = loaned_tasks_.erase(it);
+                ++requeued;
+            }
+            updateQueueStats();
+        }
+        if (requeued > 0) {
+            task_available_.notify_all();
+            interactive_available_.notify_all();
+        }
+    }
+
+    void stopProcessing() {
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            if (shutdown_requested_) return;
+            shutdown_requested_ = true;
+        }
+        faults_.stop();
+        task_available_.notify_all();
+        interactive_available_.notify_all();
+        for (auto &worker_thread : workers_) {
+            if (worker_thread.joinable()) worker_thread.join();
+        }
+    }
+//----------------------------------------------------------------------------
+
+private:
+    void finishTask(const std::shared_ptr<OcrTask>& task, const std::string& text, bool failed) {
+        task->failed = failed;
+        if (completion_listener_) completion_listener_(*task, text);
+        try {
+            task->text_promise.set_value(text);
+        } catch (...) {}
+        if (task->on_complete) task->on_complete(*task, text);
+    }
+
+    // Linear scan under queue_mutex_; the queue is short next to the cost of
+    // recognizing any one task. A worker with no runnable interactive task
+    // falls back to the bulk lane unless it is reserved for interactive work.
+    template <typename Runnable>
+    std::deque<std::shared_ptr<OcrTask>>::iterator nextPendingTask(bool interactive_only,
+                                                                   const Runnable& runnable) {
+        auto now = std::chrono::steady_clock::now();
+        if (interactive_only || pending_interactive_ > 0) {
+            auto next = pickNextTask(pending_tasks_, true, scheduling_.shortest_first,
+                                     scheduling_.aging, now, runnable);
+            if (interactive_only || next != pending_tasks_.end()) return next;
+        }
+        return pickNextTask(pending_tasks_, false, scheduling_.shortest_first,
+                            scheduling_.aging, now, runnable);
+    }
+
+    // Whether a worker holding `engines` should take the task. A task for a
+    // profile no ready worker has (journaled or stolen before its engines
+    // failed) is taken by anyone once warm-up is over, so it fails instead
+    // of waiting forever. Caller holds queue_mutex_.
+    bool runnableOn(const EngineSet& engines, const OcrTask& task) const {
+        if (engines.count(task.profile_name)) return true;
+        auto it = profile_workers_.find(task.profile_name);
+        return warming_workers_ == 0 && (it == profile_workers_.end() || it->second == 0);
+    }
+
+    // Tasks a worker passes over need a worker with the profile, which
+    // notify_one may not reach. Caller holds queue_mutex_.
+    bool everyWorkerRuns(const OcrTask& task) const {
+        auto it = profile_workers_.find(task.profile_name);
+        return warming_workers_ == 0 && it != profile_workers_.end() &&
+               it->second >= static_cast<int>(ready_workers_);
+    }
+
+    void updateQueueStats() {
+        stats_.pending_tasks = static_cast<int64_t>(pending_tasks_.size());
+        stats_.pending_interactive = static_cast<int64_t>(pending_interactive_);
+    }
+
+    static std::string costKey(const OcrTask& task) {
+        return task.profile_name + ":" + task.language_code;
+    }
+
+    void predictCost(OcrTask& task) {
+        if (task.cost_features.megapixels <= 0.0) {
+            task.cost_features = CostModel::featuresFromHeader(task.image_data);
+        }
+        task.predicted_ms = cost_model_.predict(costKey(task), task.cost_features);
+    }
+
+    // Trains the model on tasks that ran the normal page path and tracks how
+    // far off the queue-time prediction was.
+    void recordAllocations(const OcrTask& task) {
+        stats_.profiled_tasks++;
+        uint64_t allocations = 0, bytes = 0;
+        for (size_t stage = 0; stage < kAllocationStages; ++stage) {
+            const AllocationSample& sample = task.allocation_stages[stage];
+            stats_.stage_allocations[stage] += sample.allocations;
+            stats_.stage_allocated_bytes[stage] += sample.bytes;
+            raiseToAtLeast(stats_.stage_peak_bytes[stage], sample.peak_live_bytes);
+            allocations += sample.allocations;
+            bytes += sample.bytes;
+        }
+        raiseToAtLeast(stats_.task_peak_bytes, task.allocation_peak_bytes);
+        std::cout << "[Alloc] " << task.file_name << ": " << allocations << " allocations, "
+                  << bytes / 1024 << " KiB, peak " << task.allocation_peak_bytes / 1024 << " KiB live"
+                  << std::endl;
+    }
+
+    void recordCost(const OcrTask& task, bool failed) {
+        if (failed || task.template_matched || task.cost_features.ink_density < 0.0) return;
+        cost_model_.update(costKey(task), task.cost_features, static_cast<double>(task.recognition_ms));
+        stats_.cost_predictions++;
+        stats_.cost_actual_ms += static_cast<uint64_t>(task.recognition_ms);
+        stats_.cost_abs_error_ms += static_cast<uint64_t>(
+            std::llround(std::abs(task.recognition_ms - task.predicted_ms)));
+    }
+
+    std::unique_ptr<EngineSet> createEngineSet(std::set<std::string>& failed_profiles) {
+        auto engines = std::make_unique<EngineSet>();
+        for (const auto& entry : profiles_.all()) {
+            auto engine = std::make_unique<tesseract::TessBaseAPI>();
+            if (!initializeEngine(*engine, entry.second, tessdata_path_)) {
+                std::cerr << "[Worker " << std::this_thread::get_id()
+                          << "] OCR engine initialization failed for profile: "
+                          << entry.first << std::endl;
+                failed_profiles.insert(entry.first);
+            }
+            (*engines)[entry.first] = std::move(engine);
+        }
+        if (osd_.enabled) {
+            auto detector = std::make_unique<tesseract::TessBaseAPI>();
+            if (detector->Init(tessdata_path_.c_str(), "osd")) {
+                std::cerr << "[Worker " << std::this_thread::get_id()
+                          << "] OSD engine initialization failed, script detection disabled"
+                          << std::endl;
+            } else {
+                detector->SetPageSegMode(tesseract::PSM_OSD_ONLY);
+                (*engines)[kOsdEngineKey] = std::move(detector);
+            }
+        }
+        return engines;
+    }
+
+    // A small page of dark bars in text-line proportions, enough to make
+    // Tesseract load its models and run a full recognition pass.
+    static Pix* warmUpPage() {
+        Pix* page_pix = pixCreate(400, 64, 8);
+        if (!page_pix) return nullptr;
+        pixSetAll(page_pix);
+        l_uint32* data = pixGetData(page_pix);
+        const int words_per_line = pixGetWpl(page_pix);
+        for (int y = 20; y < 44; ++y) {
+            l_uint32* line = data + y * words_per_line;
+            for (int x = 16; x < 384; ++x) {
+                if ((x / 4) % 4 != 3 && (x / 48) % 5 != 4) SET_DATA_BYTE(line, x, 0);
+            }
+        }
+        return page_pix;
+    }
+
+    // Initializes every profile's engine and runs one recognition on each, so
+    // that the first real task does not pay for lazily loaded models. A
+    // profile whose engine fails to initialize or to recognize is left out of
+    // the set and named in failed_profiles; nullptr when every profile failed.
+    std::unique_ptr<EngineSet> prepareEngineSet(std::set<std::string>& failed_profiles) {
+        auto started = std::chrono::steady_clock::now();
+        auto engines = createEngineSet(failed_profiles);
+        Pix* page_pix = warmUpPage();
+        for (const auto& entry : profiles_.all()) {
+            if (failed_profiles.count(entry.first)) continue;
+            tesseract::TessBaseAPI& engine = *engines->at(entry.first);
+            char* text = page_pix ? (engine.SetImage(page_pix), engine.GetUTF8Text()) : nullptr;
+            if (text) delete [] text;
+            else failed_profiles.insert(entry.first);
+            engine.Clear();
+        }
+        pixDestroy(&page_pix);
+
+        for (const std::string& name : failed_profiles) {
+            std::cerr << "[Worker " << std::this_thread::get_id() << "] Warm-up failed for profile "
+                      << name << ", profile unavailable on this worker" << std::endl;
+            engines->erase(name);
+        }
+        if (failed_profiles.size() == profiles_.all().size()) return nullptr;
+        std::cout << "[Worker " << std::this_thread::get_id() << "] Engines warm after "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - started).count()
+                  << " ms" << std::endl;
+        return engines;
+    }
+
+    // Returns the profile's engine, or a variant of it for another language
+    // that is initialized on first use and then kept with the worker's set.
+    tesseract::TessBaseAPI& engineFor(WorkerEngineState& state, const std::string& profile_name,
+                                      const std::string& language) {
+        const RecognitionProfile& profile = *profiles_.find(profile_name);
+        if (language == profile.language) return *state.engines->at(profile_name);
+
+        const std::string key = profile_name + "@" + language;
+        auto it = state.engines->find(key);
+        if (it != state.engines->end()) return *it->second;
+        if (state.unavailable_engines.count(key)) return *state.engines->at(profile_name);
+
+        RecognitionProfile variant = profile;
+        variant.language = language;
+        auto engine = std::make_unique<tesseract::TessBaseAPI>();
+        if (!initializeEngine(*engine, variant, tessdata_path_)) {
+            std::cerr << "[Worker " << std::this_thread::get_id()
+                      << "] OCR engine initialization failed for " << key << std::endl;
+            state.unavailable_engines.insert(key);
+            return *state.engines->at(profile_name);
+        }
+        return *state.engines->emplace(key, std::move(engine)).first->second;
+    }
+
+    // Recognizes each mapped field rectangle on its own and returns the
+    // fields as "name: text" lines. The engine's page segmentation mode is
+    // switched per field and restored afterwards.
+    std::string recognizeFormFields(tesseract::TessBaseAPI& engine, const FormTemplate& form,
+                                    const TemplateAlignment& alignment, Pix* page_pix,
+                                    OcrTask& task) {
+        const tesseract::PageSegMode page_mode = profiles_.find(task.profile_name)->page_seg_mode;
+        const int page_width = pixGetWidth(page_pix);
+        const int page_height = pixGetHeight(page_pix);
+        std::string combined;
+
+        for (const FormFieldRegion& region : form.fields) {
+            int left = static_cast<int>(std::lround(region.x * alignment.scale)) + alignment.offset_x;
+            int top = static_cast<int>(std::lround(region.y * alignment.scale)) + alignment.offset_y;
+            int right = left + static_cast<int>(std::lround(region.width * alignment.scale));
+            int bottom = top + static_cast<int>(std::lround(region.height * alignment.scale));
+            left = std::max(0, left);
+            top = std::max(0, top);
+            right = std::min(page_width, right);
+            bottom = std::min(page_height, bottom);
+
+            FormFieldResult field;
+            field.set_name(region.name);
+            if (right > left && bottom > top) {
+                engine.SetPageSegMode(region.single_line ? tesseract::PSM_SINGLE_LINE
+                                                         : tesseract::PSM_SINGLE_BLOCK);
+                engine.SetRectangle(left, top, right - left, bottom - top);
+                std::unique_ptr<char[]> text(engine.GetUTF8Text());
+                std::string value = text ? text.get() : "";
+                while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+                    value.pop_back();
+                }
+                field.set_text(value);
+                field.set_confidence(std::max(0, engine.MeanTextConf()));
+            }
+            combined += region.name + ": " + field.text() + "\n";
+            task.form_fields.push_back(field);
+        }
+
+        engine.SetPageSegMode(page_mode);
+        task.template_matched = true;
+        return combined;
+    }
+
+    // Reuses cached text for unchanged bands and recognizes only the others,
+    // each restricted to its rectangle; bands are joined top to bottom.
+    std::string recognizeTiles(tesseract::TessBaseAPI& engine, Pix* page_pix, const OcrTask& task,
+                               const std::string& language) {
+        std::string text;
+        for (const PageTile& tile : layoutTiles(page_pix)) {
+            std::ostringstream key;
+            key << task.profile_name << ':' << language << ":tile:" << std::hex << tile.hash;
+            std::string tile_text;
+            if (tile_cache_.lookup(key.str(), tile_text)) {
+                stats_.tile_hits++;
+            } else {
+                stats_.tile_misses++;
+                engine.SetRectangle(tile.x, tile.y, tile.width, tile.height);
+                std::unique_ptr<char[]> recognized(engine.GetUTF8Text());
+                tile_text = recognized ? recognized.get() : "";
+                tile_cache_.insert(key.str(), tile_text);
+            }
+            text += tile_text;
+        }
+        return text;
+    }
+
+    bool detectScript(WorkerEngineState& state, const OcrTask& task, Pix* gray_pix,
+                      ScriptDetection& detection) {
+        // Only the script is shared within a batch; a sideways scan must not
+        // turn the upright pages after it, so orientation runs on every page.
+        std::string batch_script;
+        if (!task.batch_key.empty()) {
+            std::lock_guard<std::mutex> guard(detection_mutex_);
+            auto cached = batch_scripts_.find(task.batch_key);
+            if (cached != batch_scripts_.end()) batch_script = cached->second;
+        }
+        auto use_batch_script = [&] {
+            detection.script = batch_script;
+            stats_.osd_batch_hits++;
+            return true;
+        };
+
+        auto detector = state.engines->find(kOsdEngineKey);
+        if (detector == state.engines->end()) {
+            detection.rotation_degrees = 0;
+            return batch_script.empty() ? false : use_batch_script();
+        }
+
+        int largest_side = std::max(pixGetWidth(gray_pix), pixGetHeight(gray_pix));
+        float scale = largest_side > kOsdMaxDimension
+                          ? static_cast<float>(kOsdMaxDimension) / largest_side : 1.0f;
+        Pix* small_pix = scale < 1.0f ? pixScale(gray_pix, scale, scale) : pixClone(gray_pix);
+
+        int orientation_degrees = 0;
+        float orientation_confidence = 0.0f;
+        const char* script_name = nullptr;
+        float script_confidence = 0.0f;
+        detector->second->SetImage(small_pix);
+        bool detected = detector->second->DetectOrientationScript(
+            &orientation_degrees, &orientation_confidence, &script_name, &script_confidence);
+        detector->second->Clear();
+        pixDestroy(&small_pix);
+        stats_.osd_runs++;
+
+        detection.rotation_degrees = detected && orientation_confidence >= kMinOrientationConfidence
+                                         ? orientation_degrees : 0;
+        if (!batch_script.empty()) return use_batch_script();
+        if (!detected || !script_name) return false;
+        detection.script = script_confidence >= kMinScriptConfidence ? script_name : "";
+
+        if (!task.batch_key.empty() && !detection.script.empty()) {
+            std::lock_guard<std::mutex> guard(detection_mutex_);
+            if (batch_scripts_.emplace(task.batch_key, detection.script).second) {
+                batch_detection_order_.push_back(task.batch_key);
+                if (batch_detection_order_.size() > kMaxBatchDetections) {
+                    batch_scripts_.erase(batch_detection_order_.front());
+                    batch_detection_order_.pop_front();
+                }
+            }
+        }
+        return true;
+    }
+
+    // Replacement engines are initialized on a background thread while the
+    // worker keeps serving with the old ones, then swapped in between tasks.
+    // Only one worker per process rebuilds at a time so a shared RSS limit
+    // does not make every worker re-Init at once.
+    void recycleEnginesIfNeeded(WorkerEngineState& state) {
+        size_t resident = currentResidentBytes();
+        stats_.resident_bytes = resident;
+
+        if (state.replacement.valid()) {
+            if (state.replacement.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return;
+            }
+            std::unique_ptr<EngineSet> replacement = state.replacement.get();
+            recycle_in_flight_ = false;
+            if (replacement && !coversProfiles(*replacement, *state.engines)) replacement.reset();
+            if (!replacement) {
+                // Keep serving with the current engines until the next limit.
+                std::cerr << "[Worker " << std::this_thread::get_id()
+                          << "] Replacement engines failed warm-up, keeping the current ones" << std::endl;
+                state.tasks_since_init = 0;
+                state.resident_at_init = resident;
+                return;
+            }
+            countProfiles(*state.engines, -1);
+            countProfiles(*replacement, 1);
+            state.engines = std::move(replacement);
+            state.unavailable_engines.clear();
+            std::cout << "[Worker " << std::this_thread::get_id()
+                      << "] Recycled OCR engines after " << state.tasks_since_init
+                      << " tasks (RSS " << resident / (1024 * 1024) << " MB, "
+                      << (static_cast<long long>(resident) - static_cast<long long>(state.resident_at_init)) / (1024 * 1024)
+                      << " MB since last init)" << std::endl;
+            state.tasks_since_init = 0;
+            state.resident_at_init = currentResidentBytes();
+            stats_.engine_recycles++;
+            return;
+        }
+
+        bool task_limit = recycle_policy_.max_tasks > 0 &&
+                          state.tasks_since_init >= recycle_policy_.max_tasks;
+        bool memory_limit = recycle_policy_.max_growth_bytes > 0 &&
+                            state.tasks_since_init >= EngineRecyclePolicy::kMinTasksBetweenRecycles &&
+                            resident > state.resident_at_init &&
+                            resident - state.resident_at_init >= recycle_policy_.max_growth_bytes;
+        if (!task_limit && !memory_limit) return;
+
+        bool expected = false;
+        if (!recycle_in_flight_.compare_exchange_strong(expected, true)) return;
+        state.replacement = std::async(std::launch::async, [this] {
+            std::set<std::string> failed_profiles;
+            return prepareEngineSet(failed_profiles);
+        });
+    }
+
+    // A replacement set may only drop engines that were missing before, so
+    // recycling never takes a profile away from a worker.
+    bool coversProfiles(const EngineSet& replacement, const EngineSet& current) const {
+        for (const auto& entry : profiles_.all()) {
+            if (current.count(entry.first) && !replacement.count(entry.first)) return false;
+        }
+        return true;
+    }
+
+    void countProfiles(const EngineSet& engines, int delta) {
+        std::lock_guard<std::mutex> guard(queue_mutex_);
+        for (const auto& entry : profiles_.all()) {
+            if (engines.count(entry.first)) profile_workers_[entry.first] += delta;
+        }
+    }
+
+    void processTasks(bool reserved_interactive) {
+        WorkerEngineState engine_state;
+        std::set<std::string> failed_profiles;
+        engine_state.engines = prepareEngineSet(failed_profiles);
+        engine_state.resident_at_init = currentResidentBytes();
+        if (engine_state.engines) countProfiles(*engine_state.engines, 1);
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            warming_workers_--;
+            if (engine_state.engines) ready_workers_++;
+            (engine_state.engines ? stats_.workers_ready : stats_.workers_failed)++;
+        }
+        readiness_changed_.notify_all();
+        // Tasks passed over while a profile was still warming may now be
+        // runnable here, or by anyone if no worker got the profile.
+        task_available_.notify_all();
+        interactive_available_.notify_all();
+        if (!engine_state.engines) {
+            // Out of rotation: this worker never takes a task.
+            std::cerr << "[Worker " << std::this_thread::get_id()
+                      << "] No usable engine for any profile, worker taken out of rotation" << std::endl;
+            return;
+        }
+
+        while (true) {
+            std::shared_ptr<OcrTask> current_task;
+            // Each fault stage is stretched by the time it took itself.
+            std::chrono::steady_clock::time_point dequeue_start;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                auto runnable = [&](const std::shared_ptr<OcrTask>& task) {
+                    return runnableOn(*engine_state.engines, *task);
+                };
+                // Shadow copies only when no real task is runnable here.
+                std::deque<std::shared_ptr<OcrTask>>::iterator next;
+                bool from_shadow = false;
+                auto find_work = [&] {
+                    next = nextPendingTask(reserved_interactive, runnable);
+                    from_shadow = next == pending_tasks_.end() && !reserved_interactive;
+                    if (from_shadow) next = std::find_if(shadow_tasks_.begin(), shadow_tasks_.end(), runnable);
+                    return next != (from_shadow ? shadow_tasks_.end() : pending_tasks_.end());
+                };
+                (reserved_interactive ? interactive_available_ : task_available_).wait(lock, [&] {
+                    return shutdown_requested_ || find_work();
+                });
+
+                if (shutdown_requested_ && !find_work()) return;
+                dequeue_start = std::chrono::steady_clock::now();
+
+                current_task = *next;
+                if (from_shadow) {
+                    shadow_tasks_.erase(next);
+                } else {
+                    pending_tasks_.erase(next);
+                    if (current_task->interactive) pending_interactive_--;
+                    running_predictions_[current_task->task_id] = {current_task->predicted_ms,
+                                                                   std::chrono::steady_clock::now()};
+                }
+                busy_workers_++;
+                updateQueueStats();
+
+                std::cout << "[Queue] Task dequeued: " << current_task->file_name
+                          << ", Pending tasks: " << pending_tasks_.size() << std::endl;
+            }
+
+            std::cout << "[Worker " << std::this_thread::get_id() 
+                      << "] Started processing: " << current_task->file_name << std::endl;
+
+            auto recognition_start = std::chrono::steady_clock::now();
+            std::string extracted_text;
+            bool task_failed = false;
+            AllocationMeter allocation_meter;
+
+            try {
+                if (faults_.inject("dequeue", stats_)) {
+                    throw std::runtime_error("injected fault at dequeue");
+                }
+                // Only taken without the profile when no worker has it.
+                if (!engine_state.engines->count(current_task->profile_name)) {
+                    throw std::runtime_error("recognition profile " + current_task->profile_name +
+                                             " unavailable on this worker");
+                }
+                faults_.stretch("dequeue", dequeue_start, stats_);
+                // Tasks from peers and the journal were never checked here.
+                std::string decode_error;
+                auto decode_start = std::chrono::steady_clock::now();
+                Pix* image_pix = faults_.inject("decode", stats_) ? nullptr :
+                    decodeLimitedImage(current_task->image_data.data(), current_task->image_data.size(),
+                                       image_limits_, stats_, decode_error);
+                faults_.stretch("decode", decode_start, stats_);
+                current_task->allocation_stages[0] = allocation_meter.lap();
+
+                if (!image_pix) {
+                    extracted_text.clear();
+                    task_failed = true;
+                    std::cout << "[Worker " << std::this_thread::get_id()
+                              << "] Failed to read image: " << current_task->file_name
+                              << (decode_error.empty() ? "" : " (" + decode_error + ")") << std::endl;
+                } else {
+                    // PREPROCESSING
+                    const size_t strips = stripCountFor(image_pix, scheduling_.parallel_preprocess_mp,
+                                                       scheduling_.max_strips);
+                    if (strips > 1) stats_.parallel_preprocess_pages++;
+                    Pix* gray_pix = convertTo8Strips(image_pix, strips);
+                    pixDestroy(&image_pix);
+                    if (!gray_pix) throw std::runtime_error("gray conversion failed");
+                    current_task->cost_features.ink_density = CostModel::inkDensity(gray_pix);
+
+                    std::string language = profiles_.find(current_task->profile_name)->language;
+                    ScriptDetection detection;
+                    if (osd_.enabled && !current_task->keep_orientation &&
+                        detectScript(engine_state, *current_task, gray_pix, detection)) {
+                        // OSD reports how far the page is turned clockwise;
+                        // the remaining quarter turns make it upright.
+                        if (detection.rotation_degrees % 360 != 0) {
+                            Pix* upright_pix = pixRotateOrth(gray_pix,
+                                                             (360 - detection.rotation_degrees) / 90 % 4);
+                            if (upright_pix) {
+                                pixDestroy(&gray_pix);
+                                gray_pix = upright_pix;
+                                stats_.pages_rotated++;
+                            }
+                        }
+                        auto mapped = osd_.script_languages.find(detection.script);
+                        if (mapped != osd_.script_languages.end()) language = mapped->second;
+                    }
+                    // The cost model learns under the engine's language.
+                    current_task->language_code = language;
+
+                    std::shared_ptr<const FormTemplate> form;
+                    TemplateAlignment alignment;
+                    if (!current_task->form_template.empty()) {
+                        form = templates_.find(current_task->form_template);
+                        if (form && !alignToTemplate(*form, gray_pix, alignment)) form.reset();
+                        if (form) stats_.template_matches++;
+                        else stats_.template_misses++;
+                    }
+
+                    const RecognitionProfile& profile = *profiles_.find(current_task->profile_name);
+                    auto preprocess_start = std::chrono::steady_clock::now();
+                    Pix* enhanced_pix = profile.sauvola
+                        ? sauvolaBinarize(gray_pix, profile.sauvola_window, profile.sauvola_k, strips)
+                        : gammaTRCStrips(gray_pix, 1.2f, 50, 180, strips);
+                    pixDestroy(&gray_pix);
+                    if (!enhanced_pix) throw std::runtime_error("preprocessing failed");
+                    uint64_t preprocess_us = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - preprocess_start).count());
+                    (profile.sauvola ? stats_.sauvola_pages : stats_.gamma_pages)++;
+                    (profile.sauvola ? stats_.sauvola_us : stats_.gamma_us) += preprocess_us;
+                    current_task->allocation_stages[1] = allocation_meter.lap();
+
+                    tesseract::TessBaseAPI& ocr_engine =
+                        engineFor(engine_state, current_task->profile_name, language);
+                    auto recognize_start = std::chrono::steady_clock::now();
+                    if (faults_.inject("recognize", stats_)) {
+                        pixDestroy(&enhanced_pix);
+                        throw std::runtime_error("injected fault at recognize");
+                    }
+                    ocr_engine.SetImage(enhanced_pix);
+
+                    if (form) {
+                        extracted_text = recognizeFormFields(
+                            ocr_engine, *form, alignment, enhanced_pix, *current_task);
+                    } else if (tile_cache_.enabled() && !current_task->want_word_boxes) {
+                        extracted_text = recognizeTiles(ocr_engine, enhanced_pix, *current_task, language);
+                    } else {
+                        char* ocr_result = ocr_engine.GetUTF8Text();
+                        if (ocr_result) {
+                            extracted_text = std::string(ocr_result);
+                            delete [] ocr_result;
+                        }
+                        if (current_task->want_word_boxes) {
+                            collectWordBoxes(ocr_engine, extracted_text, current_task->word_boxes);
+                        }
+                    }
+
+                    ocr_engine.Clear();
+                    pixDestroy(&enhanced_pix);
+                    current_task->allocation_stages[2] = allocation_meter.lap();
+                    faults_.stretch("recognize", recognize_start, stats_);
+                }
+
+            } catch (const std::exception& ex) {
+                extracted_text = std::string("ERROR: ") + ex.what();
+                task_failed = true;
+            } catch (...) {
+                extracted_text = "ERROR: unknown exception";
+                task_failed = true;
+            }
+
+            auto complete_start = std::chrono::steady_clock::now();
+            if (faults_.inject("complete", stats_) && !task_failed) {
+                extracted_text = "ERROR: injected fault at complete";
+                task_failed = true;
+            }
+
+            current_task->recognition_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - recognition_start).count();
+            recordCost(*current_task, task_failed);
+            if (g_allocation_profiling) {
+                current_task->allocation_peak_bytes = allocation_meter.taskPeakBytes();
+                recordAllocations(*current_task);
+            }
+            if (current_task->shadow) {
+                // Shadow runs are reported through their own counters.
+            } else if (task_failed) {
+                stats_.tasks_failed++;
+            } else {
+                stats_.tasks_completed++;
+            }
+
+            std::cout << "[Worker " << std::this_thread::get_id() 
+                      << "] Finished processing: " << current_task->file_name
+                      << " (" << extracted_text.size() << " chars)" << std::endl;
+
+            faults_.stretch("complete", complete_start, stats_);
+            finishTask(current_task, extracted_text, task_failed);
+            {
+                std::lock_guard<std::mutex> guard(queue_mutex_);
+                running_predictions_.erase(current_task->task_id);
+                busy_workers_--;
+            }
+
+            engine_state.tasks_since_init++;
+            recycleEnginesIfNeeded(engine_state);
+        }
+    }
+
+    std::string tessdata_path_;
+    const ProfileCatalog& profiles_;
+    EngineRecyclePolicy recycle_policy_;
+    OsdOptions osd_;
+    TemplateRegistry& templates_;
+    FaultInjector& faults_;
+    ResultCache& tile_cache_;
+    SchedulingPolicy scheduling_;
+    ImageLimits image_limits_;
+    CostModel cost_model_;
+    ProcessStats& stats_;
+    std::atomic<bool> recycle_in_flight_;
+    std::function<void(const OcrTask&, const std::string&)> completion_listener_;
+    std::mutex detection_mutex_;
+    std::unordered_map<std::string, std::string> batch_scripts_;
+    std::deque<std::string> batch_detection_order_;
+
+    struct Loan {
+        std::shared_ptr<OcrTask> task;
+        std::string thief;
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    uint64_t next_task_id_;
+    size_t busy_workers_;
+    size_t warming_workers_;
+    size_t ready_workers_;
+    std::condition_variable readiness_changed_;
+    std::map<std::string, int> profile_workers_;  // workers with a warm engine, by profile
+    std::unordered_map<uint64_t, Loan> loaned_tasks_;
+    // Predicted cost and start time of tasks currently on a worker.
+    std::unordered_map<uint64_t, std::pair<double, std::chrono::steady_clock::time_point>> running_predictions_;
+    std::deque<std::shared_ptr<OcrTask>> pending_tasks_;
+    std::deque<std::shared_ptr<OcrTask>> shadow_tasks_;  // lowest lane, outside pending_tasks_
+    size_t pending_interactive_ = 0;
+    std::mutex queue_mutex_;
+    std::condition_variable task_available_;
+    std::condition_variable interactive_available_;
+    std::vector<std::thread> workers_;
+    bool shutdown_requested_;
+};
+
+// SHADOW TRAFFIC -------------------------------------------------------------
+// Mirrors a sample of finished requests to an alternate profile while local
+// workers are idle. The copy's result is discarded; only its latency and its
+// word-level edit distance from the served text are added to the stats.
+class ShadowMirror {
+public:
+    static constexpr size_t kMaxComparedWords = 4000;
+
+    ShadowMirror(TaskProcessor& processor, const std::string& profile_name, double sample_rate,
+                 ProcessStats& stats)
+        : processor_(processor), profile_name_(profile_name), sample_rate_(sample_rate),
+          stats_(stats), random_(std::random_device{}()) {}
+
+    bool enabled() const { return !profile_name_.empty() && sample_rate_ > 0.0; }
+
+    // Called from the completion listener with the primary task's result.
+    void maybeMirror(const OcrTask& primary, const std::string& text) {
+        if (!enabled() || primary.shadow || primary.failed || primary.on_complete ||
+            primary.template_matched || primary.profile_name == profile_name_) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(random_mutex_);
+            if (std::uniform_real_distribution<double>(0.0, 1.0)(random_) >= sample_rate_) return;
+        }
+        // The calling worker still counts as busy, so this asks for a worker
+        // that no queued shadow copy has claimed yet.
+        if (processor_.idleWorkerCount() <= processor_.queuedShadowTasks() ||
+            processor_.profileReadiness(profile_name_) != TaskProcessor::ProfileReadiness::Ready) {
+            stats_.shadow_skipped++;
+            return;
+        }
+
+        auto mirror = std::make_shared<OcrTask>();
+        mirror->shadow = true;
+        mirror->interactive = false;
+        mirror->file_name = primary.file_name;
+        mirror->language_code = primary.language_code;
+        mirror->profile_name = profile_name_;
+        mirror->image_data = primary.image_data;
+        mirror->task_start_time = std::chrono::steady_clock::now();
+        const long long primary_ms = primary.recognition_ms;
+        mirror->on_complete = [this, text, primary_ms](const OcrTask& shadow_task,
+                                                       const std::string& shadow_text) {
+            record(text, primary_ms, shadow_task, shadow_text);
+        };
+        processor_.submitTask(mirror);
+    }
+
+private:
+    static std::vector<std::string> words(const std::string& text) {
+        std::vector<std::string> tokens;
+        std::istringstream stream(text);
+        std::string token;
+        while (stream >> token && tokens.size() < kMaxComparedWords) tokens.push_back(token);
+        return tokens;
+    }
+
+    static size_t wordEditDistance(const std::vector<std::string>& a,
+                                   const std::vector<std::string>& b) {
+        std::vector<size_t> previous(b.size() + 1), current(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); ++j) previous[j] = j;
+        for (size_t i = 1; i <= a.size(); ++i) {
+            current[0] = i;
+            for (size_t j = 1; j <= b.size(); ++j) {
+                size_t substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+                current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+            }
+            std::swap(previous, current);
+        }
+        return previous[b.size()];
+    }
+
+    void record(const std::string& primary_text, long long primary_ms,
+                const OcrTask& shadow_task, const std::string& shadow_text) {
+        if (shadow_task.failed) {
+            stats_.shadow_skipped++;
+            return;
+        }
+        std::vector<std::string> primary_words = words(primary_text);
+        size_t edits = wordEditDistance(primary_words, words(shadow_text));
+
+        stats_.shadow_runs++;
+        if (edits == 0) stats_.shadow_identical++;
+        stats_.shadow_word_edits += edits;
+        stats_.shadow_words += primary_words.size();
+        stats_.shadow_primary_ms += static_cast<uint64_t>(primary_ms);
+        stats_.shadow_ms += static_cast<uint64_t>(shadow_task.recognition_ms);
+
+        std::cout << "[Shadow] " << shadow_task.file_name << ": " << primary_ms << " ms -> "
+                  << shadow_task.recognition_ms << " ms with profile " << profile_name_
+                  << ", " << edits << "/" << primary_words.size() << " words differ" << std::endl;
+    }
+
+    TaskProcessor& processor_;
+    std::string profile_name_;
+    double sample_rate_;
+    ProcessStats& stats_;
+    std::mutex random_mutex_;
+    std::mt19937_64 random_;
+};
+//----------------------------------------------------------------------------
+
+// WORK STEALING --------------------------------------------------------------
+// Polls the static peer list while local workers are idle and pulls queued
+// tasks from overloaded peers. The image travels once, peer to thief; only
+// the text goes back. The same thread also requeues tasks this node lent out
+// whose thief never answered.
+class PeerStealer {
+public:
+    PeerStealer(TaskProcessor& processor, const ProfileCatalog& profiles,
+                const ServerOptions& options, ProcessStats& stats)
+        : processor_(processor), profiles_(profiles), self_endpoint_(options.endpoint),
+          thief_id_(makeThiefId(options.endpoint)), stats_(stats), next_peer_(0), stop_(false) {
+        for (const std::string& endpoint : options.peer_endpoints) {
+            peers_.push_back(OCRService::NewStub(
+                grpc::CreateChannel(endpoint, grpc::InsecureChannelCredentials())));
+            peer_names_.push_back(endpoint);
+        }
+        thread_ = std::thread(&PeerStealer::run, this);
+        sender_ = std::thread(&PeerStealer::sendResults, this);
+    }
+
+    // Results already queued are still sent before the sender exits.
+    ~PeerStealer() {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        results_ready_.notify_all();
+        if (thread_.joinable()) thread_.join();
+        if (sender_.joinable()) sender_.join();
+    }
+
+private:
+    struct PendingResult {
+        size_t peer_index;
+        StolenTaskResult result;
+    };
+
+    // Loans are keyed by thief, so the id must differ between nodes that
+    // share a default --endpoint and between prefork children of one node.
+    static std::string makeThiefId(const std::string& endpoint) {
+        std::ostringstream id;
+        id << endpoint << "/" << getpid() << "/" << std::hex
+           << std::mt19937_64(std::random_device{}())();
+        return id.str();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            wake_.wait_for(lock, std::chrono::milliseconds(100));
+            if (stop_) break;
+            lock.unlock();
+
+            processor_.requeueExpiredLoans();
+            if (!peers_.empty()) {
+                size_t idle = processor_.idleWorkerCount();
+                if (idle > 0) stealFrom(next_peer_++ % peers_.size(), idle);
+            }
+
+            lock.lock();
+        }
+    }
+
+    void stealFrom(size_t peer_index, size_t max_tasks) {
+        StealTasksRequest request;
+        request.set_thief(thief_id_);
+        request.set_max_tasks(static_cast<int32_t>(max_tasks));
+        StealTasksResponse response;
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+        if (!peers_[peer_index]->StealTasks(&context, request, &response).ok()) return;
+
+        for (const StolenTask& stolen : response.tasks()) {
+            uint64_t origin_id = stolen.task_id();
+            auto task = std::make_shared<OcrTask>();
+            task->file_name = stolen.filename();
+            task->task_start_time = std::chrono::steady_clock::now();
+            task->image_data.assign(stolen.image().begin(), stolen.image().end());
+
+            const RecognitionProfile* profile = profiles_.find(stolen.profile());
+            if (!profile || processor_.profileReadiness(profile->name) !=
+                                TaskProcessor::ProfileReadiness::Ready) {
+                task->failed = true;
+                reportResult(peer_index, origin_id, *task,
+                             "ERROR: " + std::string(profile ? "profile unavailable" : "unknown profile") +
+                             " on " + self_endpoint_);
+                continue;
+            }
+            task->profile_name = profile->name;
+            task->language_code = profile->language;
+            task->want_word_boxes = stolen.want_word_boxes();
+            task->interactive = stolen.priority() != ocr::PRIORITY_BULK;
+            task->on_complete = [this, peer_index, origin_id](const OcrTask& finished,
+                                                              const std::string& text) {
+                reportResult(peer_index, origin_id, finished, text);
+            };
+
+            std::cout << "[Steal] Took " << task->file_name << " from "
+                      << peer_names_[peer_index] << std::endl;
+            stats_.tasks_stolen++;
+            processor_.submitTask(task);
+        }
+    }
+
+    void reportResult(size_t peer_index, uint64_t task_id, const OcrTask& task,
+                      const std::string& text) {
+        PendingResult pending{peer_index, StolenTaskResult()};
+        pending.result.set_task_id(task_id);
+        pending.result.set_thief(thief_id_);
+        pending.result.set_text(text);
+        pending.result.set_failed(task.failed);
+        if (task.want_word_boxes) *pending.result.mutable_word_boxes() = task.word_boxes;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            results_.push_back(std::move(pending));
+        }
+        results_ready_.notify_one();
+    }
+
+    // Sends finished results to their owners off the worker threads, so a
+    // slow or unreachable peer never holds up recognition.
+    void sendResults() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            results_ready_.wait(lock, [&] { return stop_ || !results_.empty(); });
+            if (results_.empty()) return;
+            PendingResult pending = std::move(results_.front());
+            results_.pop_front();
+            lock.unlock();
+
+            StolenTaskAck ack;
+            grpc::ClientContext context;
+            context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+            grpc::Status status = peers_[pending.peer_index]->CompleteStolenTask(
+                &context, pending.result, &ack);
+            if (!status.ok() || !ack.accepted()) {
+                std::cerr << "[Steal] " << peer_names_[pending.peer_index]
+                          << " did not accept result for task " << pending.result.task_id() << std::endl;
+            }
+
+            lock.lock();
+        }
+    }
+
+    TaskProcessor& processor_;
+    const ProfileCatalog& profiles_;
+    std::string self_endpoint_;
+    std::string thief_id_;
+    ProcessStats& stats_;
+    std::vector<std::unique_ptr<OCRService::Stub>> peers_;
+    std::vector<std::string> peer_names_;
+    size_t next_peer_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::deque<PendingResult> results_;
+    std::condition_variable results_ready_;
+    std::thread thread_;
+    std::thread sender_;
+};
+//----------------------------------------------------------------------------
+
+// FRAME STREAMS --------------------------------------------------------------
+// Consecutive video or screen-capture frames are compared tile by tile. Only
+// the regions around changed tiles are recognized again, and the words found
+// there replace the frame's previous words inside each region. Regions grow
+// to cover every word they cut, so a word is never half re-read.
+struct FrameWord {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    std::string text;
+};
+
+struct FrameRegion {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool intersects(const FrameWord& word) const {
+        return word.x < x + width && word.x + word.width > x &&
+               word.y < y + height && word.y + word.height > y;
+    }
+    bool contains(const FrameWord& word) const {
+        int center_x = word.x + word.width / 2;
+        int center_y = word.y + word.height / 2;
+        return center_x >= x && center_x < x + width && center_y >= y && center_y < y + height;
+    }
+    bool overlaps(const FrameRegion& other) const {
+        return other.x < x + width && other.x + other.width > x &&
+               other.y < y + height && other.y + other.height > y;
+    }
+    void include(int left, int top, int right, int bottom) {
+        int new_right = std::max(x + width, right);
+        int new_bottom = std::max(y + height, bottom);
+        x = std::min(x, left);
+        y = std::min(y, top);
+        width = new_right - x;
+        height = new_bottom - y;
+    }
+};
+
+static constexpr int kFrameTileSize = 64;
+static constexpr int kFramePixelDelta = 24;       // gray levels that count as a change
+static constexpr int kFrameRegionMargin = 8;
+static constexpr double kFrameFullRescanRatio = 0.6;  // changed tile share that re-reads everything
+
+// Marks tiles where enough pixels moved by more than kFramePixelDelta and
+// returns the bounding rectangles of 8-connected groups of changed tiles.
+static std::vector<FrameRegion> changedFrameRegions(Pix* previous, Pix* current,
+                                                    size_t& changed_tiles, size_t& total_tiles) {
+    const int width = pixGetWidth(current);
+    const int height = pixGetHeight(current);
+    const int columns = (width + kFrameTileSize - 1) / kFrameTileSize;
+    const int rows = (height + kFrameTileSize - 1) / kFrameTileSize;
+    total_tiles = static_cast<size_t>(columns) * rows;
+
+    std::vector<int> differing(total_tiles, 0);
+    l_uint32* previous_data = pixGetData(previous);
+    l_uint32* current_data = pixGetData(current);
+    const int previous_wpl = pixGetWpl(previous);
+    const int current_wpl = pixGetWpl(current);
+    for (int y = 0; y < height; ++y) {
+        l_uint32* previous_line = previous_data + y * previous_wpl;
+        l_uint32* current_line = current_data + y * current_wpl;
+        int* tile_row = differing.data() + (y / kFrameTileSize) * columns;
+        for (int x = 0; x < width; ++x) {
+            int delta = static_cast<int>(GET_DATA_BYTE(current_line, x)) - GET_DATA_BYTE(previous_line, x);
+            if (delta > kFramePixelDelta || delta < -kFramePixelDelta) tile_row[x / kFrameTileSize]++;
+        }
+    }
+
+    // A changed glyph in a 64 px tile moves well over 1/256 of its pixels;
+    // compression noise rarely crosses the pixel threshold at all.
+    std::vector<char> changed(total_tiles, 0);
+    changed_tiles = 0;
+    for (size_t tile = 0; tile < total_tiles; ++tile) {
+        int tile_width = std::min(kFrameTileSize, width - static_cast<int>(tile % columns) * kFrameTileSize);
+        int tile_height = std::min(kFrameTileSize, height - static_cast<int>(tile / columns) * kFrameTileSize);
+        if (differing[tile] >= std::max(4, tile_width * tile_height / 256)) {
+            changed[tile] = 1;
+            changed_tiles++;
+        }
+    }
+
+    std::vector<FrameRegion> regions;
+    std::vector<size_t> stack;
+    for (size_t start = 0; start < total_tiles; ++start) {
+        if (changed[start] != 1) continue;
+        int column = static_cast<int>(start % columns), row = static_cast<int>(start / columns);
+        FrameRegion region{column * kFrameTileSize, row * kFrameTileSize, 0, 0};
+        changed[start] = 2;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            size_t tile = stack.back();
+            stack.pop_back();
+            column = static_cast<int>(tile % columns);
+            row = static_cast<int>(tile / columns);
+            region.include(column * kFrameTileSize, row * kFrameTileSize,
+                           std::min(width, (column + 1) * kFrameTileSize),
+                           std::min(height, (row + 1) * kFrameTileSize));
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int c = column + dx, r = row + dy;
+                    if (c < 0 || r < 0 || c >= columns || r >= rows) continue;
+                    size_t neighbour = static_cast<size_t>(r) * columns + c;
+                    if (changed[neighbour] != 1) continue;
+                    changed[neighbour] = 2;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        regions.push_back(region);
+    }
+    return regions;
+}
+
+// Pads the regions, grows them over every word they cut and merges the ones
+// that end up overlapping.
+static void settleFrameRegions(std::vector<FrameRegion>& regions, const std::vector<FrameWord>& words,
+                               int width, int height) {
+    for (FrameRegion& region : regions) {
+        region.include(std::max(0, region.x - kFrameRegionMargin),
+                       std::max(0, region.y - kFrameRegionMargin),
+                       std::min(width, region.x + region.width + kFrameRegionMargin),
+                       std::min(height, region.y + region.height + kFrameRegionMargin));
+    }
+    bool grew = true;
+    while (grew) {
+        grew = false;
+        for (FrameRegion& region : regions) {
+            for (const FrameWord& word : words) {
+                if (!region.intersects(word)) continue;
+                FrameRegion before = region;
+                region.include(std::max(0, word.x - kFrameRegionMargin),
+                               std::max(0, word.y - kFrameRegionMargin),
+                               std::min(width, word.x + word.width + kFrameRegionMargin),
+                               std::min(height, word.y + word.height + kFrameRegionMargin));
+                if (region.width != before.width || region.height != before.height) grew = true;
+            }
+        }
+        for (size_t i = 0; i < regions.size(); ++i) {
+            for (size_t j = i + 1; j < regions.size();) {
+                if (!regions[i].overlaps(regions[j])) { ++j; continue; }
+                regions[i].include(regions[j].x, regions[j].y, regions[j].x + regions[j].width,
+                                   regions[j].y + regions[j].height);
+                regions.erase(regions.begin() + j);
+                grew = true;
+            }
+        }
+    }
+}
+
+// Words in reading order: grouped into lines by vertical overlap, then left
+// to right.
+static std::string frameWordsText(std::vector<FrameWord> words) {
+    std::sort(words.begin(), words.end(), [](const FrameWord& a, const FrameWord& b) {
+        return a.y + a.height / 2 < b.y + b.height / 2;
+    });
+    std::string text;
+    for (size_t start = 0; start < words.size();) {
+        int line_center = words[start].y + words[start].height / 2;
+        int line_half_height = std::max(1, words[start].height / 2);
+        size_t end = start + 1;
+        while (end < words.size() &&
+               std::abs(words[end].y + words[end].height / 2 - line_center) <= line_half_height) {
+            ++end;
+        }
+        std::sort(words.begin() + start, words.begin() + end,
+                  [](const FrameWord& a, const FrameWord& b) { return a.x < b.x; });
+        for (size_t i = start; i < end; ++i) {
+            if (i > start) text += ' ';
+            text += words[i].text;
+        }
+        text += '\n';
+        start = end;
+    }
+    return text;
+}
+
+static void appendFrameWords(const std::string& text, const WordBoxes& boxes, int offset_x, int offset_y,
+                             std::vector<FrameWord>& words) {
+    for (int i = 0; i < boxes.confidences_size(); ++i) {
+        uint32_t span_offset = boxes.text_spans(2 * i);
+        uint32_t span_length = boxes.text_spans(2 * i + 1);
+        if (span_length == 0 || span_offset + span_length > text.size()) continue;
+        words.push_back({boxes.boxes(4 * i) + offset_x, boxes.boxes(4 * i + 1) + offset_y,
+                         boxes.boxes(4 * i + 2), boxes.boxes(4 * i + 3),
+                         text.substr(span_offset, span_length)});
+    }
+}
+//----------------------------------------------------------------------------
+
+// gRPC Service Implementation ----------------------------------------------------
+class OCRServiceHandler final : public OCRService::Service {
+public:
+    OCRServiceHandler(TaskProcessor &processor, const ProfileCatalog &profiles,
+                      ResultCache &cache, NearDuplicateIndex &near_duplicates,
+                      JobStore &jobs, TaskJournal &journal, TextIndex &text_index,
+                      TemplateRegistry &templates, FaultInjector &faults, bool fault_injection,
+                      const ImageLimits &image_limits, RequestCapture &capture,
+                      StatsRegistry &stats)
+        : task_processor_(processor), profiles_(profiles), cache_(cache),
+          near_duplicates_(near_duplicates), jobs_(jobs), journal_(journal),
+          text_index_(text_index), templates_(templates), faults_(faults),
+          fault_injection_(fault_injection), image_limits_(image_limits), capture_(capture),
+          stats_(stats) {}
+
+    Status ProcessImage(ServerContext* context,
+                        const ProcessImageRequest* request,
+                        ProcessImageResponse* response) override {
+
+        std::cout << "[Server] Received request for image: " << request->filename()
+                  << " from client: " << request->client_id() << std::endl;
+        capture_.record("ProcessImage", *request);
+
+        const RecognitionProfile* profile = profiles_.find(request->profile());
+        if (!profile) {
+            response->set_ok(false);
+            response->set_message("Unknown recognition profile: " + request->profile());
+            return Status::OK;
+        }
+        Status readiness = checkReady(*profile);
+        if (!readiness.ok()) return readiness;
+
+        const std::string job_id = request->job_id().empty() ? jobs_.newJobId() : request->job_id();
+        response->set_job_id(job_id);
+
+        JobRecord existing;
+        if (!request->job_id().empty() && jobs_.lookup(job_id, existing)) {
+            if (existing.finished) {
+                fillFromJob(existing, response);
+            } else {
+                response->set_ok(false);
+                response->set_message("Job already pending, poll GetJobResult");
+            }
+            return Status::OK;
+        }
+
+        std::string image_error;
+        if (!admitImage(*request, image_error)) {
+            response->set_ok(false);
+            response->set_message(image_error);
+            return Status::OK;
+        }
+
+        const ContentKeys keys = computeKeys(*request, *profile);
+        if (serveFromCache(*request, *profile, keys, job_id, response)) return Status::OK;
+
+        auto new_task = createTask(*request, *profile, keys, job_id);
+        bool admitted = true;
+        response->set_eta_ms(task_processor_.estimateCompletion(*new_task, admitted));
+        if (!admitted) {
+            response->set_ok(false);
+            response->set_message("Server busy, estimated completion in " +
+                                  std::to_string(response->eta_ms()) + " ms");
+            return Status::OK;
+        }
+        std::future<std::string> text_future = new_task->text_promise.get_future();
+        if (!acceptTask(new_task)) {
+            response->set_ok(false);
+            response->set_message("Failed to journal task");
+            return Status::OK;
+        }
+
+        // FAULT TOLERANCE ---------------------------------------------------------
+        auto status = text_future.wait_for(std::chrono::seconds(120));
+        if (status == std::future_status::timeout) {
+            std::cout << "[Server] Timeout processing image: " << request->filename() << std::endl;
+            stats_.local().tasks_timed_out++;
+            response->set_ok(false);
+            response->set_message("Image processing timeout");
+            return Status::OK;
+        }
+        // -------------------------------------------------------------------------
+
+        std::string result_text = text_future.get();
+        response->set_ok(true);
+        response->set_text(result_text);
+        if (new_task->want_word_boxes) *response->mutable_word_boxes() = new_task->word_boxes;
+        response->set_template_matched(new_task->template_matched);
+        for (const FormFieldResult& field : new_task->form_fields) *response->add_form_fields() = field;
+        if (request->want_allocation_profile() && g_allocation_profiling) {
+            fillAllocationProfile(*new_task, response->mutable_allocation());
+        }
+
+        long long processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - new_task->task_start_time).count();
+        response->set_processing_time_ms(processing_time);
+        stats_.local().total_processing_ms += static_cast<uint64_t>(processing_time);
+
+        std::cout << "[Server] Finished request for image: " << request->filename()
+                  << ", Processing time: " << processing_time << " ms" << std::endl;
+
+        return Status::OK;
+    }
+
+    // Queues the image and returns its job id at once; the result is fetched
+    // with GetJobResult.
+    Status SubmitImage(ServerContext* context,
+                       const ProcessImageRequest* request,
+                       SubmitImageResponse* response) override {
+        capture_.record("SubmitImage", *request);
+        const RecognitionProfile* profile = profiles_.find(request->profile());
+        if (!profile) {
+            response->set_ok(false);
+            response->set_message("Unknown recognition profile: " + request->profile());
+            return Status::OK;
+        }
+        Status readiness = checkReady(*profile);
+        if (!readiness.ok()) return readiness;
+
+        const std::string job_id = request->job_id().empty() ? jobs_.newJobId() : request->job_id();
+        response->set_job_id(job_id);
+        response->set_ok(true);
+
+        JobRecord existing;
+        if (!request->job_id().empty() && jobs_.lookup(job_id, existing)) return Status::OK;
+
+        std::string image_error;
+        if (!admitImage(*request, image_error)) {
+            response->set_ok(false);
+            response->set_message(image_error);
+            return Status::OK;
+        }
+
+        const ContentKeys keys = computeKeys(*request, *profile);
+        ProcessImageResponse cached_response;
+        if (serveFromCache(*request, *profile, keys, job_id, &cached_response)) return Status::OK;
+
+        auto new_task = createTask(*request, *profile, keys, job_id);
+        bool admitted = true;
+        response->set_eta_ms(task_processor_.estimateCompletion(*new_task, admitted));
+        if (!admitted) {
+            response->set_ok(false);
+            response->set_message("Server busy, estimated completion in " +
+                                  std::to_string(response->eta_ms()) + " ms");
+        } else if (!acceptTask(new_task)) {
+            response->set_ok(false);
+            response->set_message("Failed to journal task");
+        }
+        return Status::OK;
+    }
+
+    Status GetJobResult(ServerContext* context,
+                        const JobResultRequest* request,
+                        JobResultResponse* response) override {
+        JobRecord record;
+        if (!jobs_.lookup(request->job_id(), record)) {
+            // In prefork mode the job may belong to another process.
+            TaskJournal::FinishedEntry entry;
+            TaskJournal::SiblingJob sibling = journal_.enabled()
+                ? journal_.findInSiblings(request->job_id(), entry) : TaskJournal::SiblingJob::Unknown;
+            if (sibling == TaskJournal::SiblingJob::Unknown) {
+                response->set_state(ocr::JOB_UNKNOWN);
+                return Status::OK;
+            }
+            if (sibling == TaskJournal::SiblingJob::Finished) {
+                record.finished = true;
+                record.failed = entry.failed;
+                record.text = entry.text;
+            }
+        }
+        response->set_state(record.finished ? ocr::JOB_DONE : ocr::JOB_PENDING);
+        response->mutable_result()->set_job_id(request->job_id());
+        if (record.finished) fillFromJob(record, response->mutable_result());
+        return Status::OK;
+    }
+
+    Status Search(ServerContext* context,
+                  const SearchRequest* request,
+                  SearchResponse* response) override {
+        if (!text_index_.enabled()) {
+            return Status(grpc::StatusCode::FAILED_PRECONDITION,
+                          "Full-text index is disabled, start the server with --index-dir");
+        }
+        size_t limit = request->limit() > 0 ? static_cast<size_t>(request->limit()) : 100;
+        size_t total_matches = 0;
+        for (const auto& match : text_index_.search(request->query(), request->batch_id(),
+                                                     limit, total_matches)) {
+            SearchHit* hit = response->add_hits();
+            hit->set_job_id(match.job_id);
+            hit->set_batch_id(match.batch_id);
+            hit->set_filename(match.file_name);
+            for (uint32_t position : match.positions) hit->add_positions(position);
+        }
+        response->set_total_hits(static_cast<uint32_t>(total_matches));
+        return Status::OK;
+    }
+
+    Status RegisterTemplate(ServerContext* context,
+                            const RegisterTemplateRequest* request,
+                            RegisterTemplateResponse* response) override {
+        if (!TemplateRegistry::validName(request->name())) {
+            response->set_ok(false);
+            response->set_message("Template names use letters, digits, '_' and '-' only");
+            return Status::OK;
+        }
+
+        std::string decode_error;
+        Pix* image_pix = decodeLimitedImage(request->reference_image(), image_limits_, stats_.local(),
+                                            decode_error);
+        Pix* gray_pix = image_pix ? pixConvertTo8(image_pix, 0) : nullptr;
+        pixDestroy(&image_pix);
+        if (!gray_pix) {
+            response->set_ok(false);
+            response->set_message("Failed to read reference image" +
+                                  (decode_error.empty() ? std::string() : ": " + decode_error));
+            return Status::OK;
+        }
+
+        FormTemplate form;
+        form.name = request->name();
+        form.width = pixGetWidth(gray_pix);
+        form.height = pixGetHeight(gray_pix);
+        bool profiled = projectionProfiles(gray_pix, form.row_profile, form.column_profile);
+        pixDestroy(&gray_pix);
+        for (const auto& field : request->fields()) {
+            if (field.x() < 0 || field.y() < 0 || field.width() <= 0 || field.height() <= 0 ||
+                field.width() > form.width - field.x() || field.height() > form.height - field.y()) {
+                response->set_ok(false);
+                response->set_message("Field " + field.name() + " must be a non-empty rectangle inside the " +
+                                      std::to_string(form.width) + "x" + std::to_string(form.height) +
+                                      " reference page");
+                return Status::OK;
+            }
+            form.fields.push_back({field.name(), field.x(), field.y(), field.width(),
+                                   field.height(), field.single_line()});
+        }
+
+        if (!profiled || !templates_.add(form)) {
+            response->set_ok(false);
+            response->set_message("Failed to store template");
+            return Status::OK;
+        }
+        std::cout << "[Server] Registered form template " << form.name << " with "
+                  << form.fields.size() << " fields" << std::endl;
+        response->set_ok(true);
+        return Status::OK;
+    }
+
+    Status SetFaults(ServerContext* context,
+                     const SetFaultsRequest* request,
+                     SetFaultsResponse* response) override {
+        if (!fault_injection_) {
+            response->set_ok(false);
+            response->set_message("Fault injection is disabled; start the server with --fault-injection");
+            return Status::OK;
+        }
+        std::string error;
+        std::vector<std::string> rules(request->rules().begin(), request->rules().end());
+        if (!faults_.setRules(rules, error)) {
+            response->set_ok(false);
+            response->set_message(error);
+            return Status::OK;
+        }
+        std::cout << "[Fault] " << rules.size() << " fault rule(s) active in process "
+                  << getpid() << std::endl;
+        response->set_ok(true);
+        for (const std::string& rule : faults_.activeRules()) response->add_active_rules(rule);
+        return Status::OK;
+    }
+
+    // Recognizes every image in a streamed tar or zip. Entries are queued as
+    // soon as they are extracted, at most kMaxArchiveEntriesInFlight at a time
+    // so upload flow control throttles the client, and a writer thread
+    // streams each result back as it completes.
+    Status ProcessArchive(ServerContext* context,
+                          ServerReaderWriter<ArchiveEntryResult, ArchiveChunk>* stream) override {
+        ArchiveChunk chunk;
+        if (!stream->Read(&chunk)) return Status::OK;
+
+        ProcessImageRequest entry_template;
+        entry_template.set_client_id(chunk.client_id());
+        entry_template.set_batch_id(chunk.batch_id());
+        entry_template.set_lang(chunk.lang());
+        entry_template.set_profile(chunk.profile());
+        entry_template.set_priority(chunk.priority());
+        const RecognitionProfile* profile = profiles_.find(chunk.profile());
+        if (!profile) {
+            return Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Unknown recognition profile: " + chunk.profile());
+        }
+        Status readiness = checkReady(*profile);
+        if (!readiness.ok()) return readiness;
+        std::cout << "[Server] Receiving archive from client: " << chunk.client_id() << std::endl;
+
+        auto progress = std::make_shared<ArchiveProgress>();
+        std::thread writer([&] {
+            std::unique_lock<std::mutex> lock(progress->mutex);
+            while (true) {
+                progress->changed.wait_for(lock, std::chrono::seconds(1), [&] {
+                    return !progress->ready.empty() || (progress->input_done && progress->in_flight == 0);
+                });
+                if (context->IsCancelled()) progress->cancelled = true;
+                if (progress->cancelled) break;
+                if (progress->ready.empty()) {
+                    if (progress->input_done && progress->in_flight == 0) break;
+                    continue;
+                }
+                ArchiveEntryResult result = std::move(progress->ready.front());
+                progress->ready.pop_front();
+                lock.unlock();
+                bool written = stream->Write(result);
+                lock.lock();
+                if (!written) progress->cancelled = true;
+            }
+            progress->changed.notify_all();
+        });
+
+        ArchiveReader reader(kMaxArchiveEntryBytes);
+        std::vector<ArchiveReader::Entry> entries;
+        uint32_t entry_index = 0;
+        std::string archive_error;
+        do {
+            if (!reader.feed(chunk.data().data(), chunk.data().size(), entries)) {
+                archive_error = reader.error();
+                break;
+            }
+            for (ArchiveReader::Entry& entry : entries) {
+                if (!submitArchiveEntry(progress, entry_template, *profile, entry_index++, entry)) break;
+            }
+            entries.clear();
+        } while (!progress->isCancelled() && stream->Read(&chunk));
+        if (archive_error.empty() && !progress->isCancelled() && !reader.complete()) {
+            archive_error = "Archive is truncated or not a tar/zip file";
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(progress->mutex);
+            progress->input_done = true;
+        }
+        progress->changed.notify_all();
+        writer.join();
+
+        std::cout << "[Server] Finished archive from client: " << entry_template.client_id()
+                  << ", " << entry_index << " entries" << std::endl;
+        if (!archive_error.empty()) return Status(grpc::StatusCode::INVALID_ARGUMENT, archive_error);
+        if (progress->isCancelled()) return Status(grpc::StatusCode::CANCELLED, "Archive upload cancelled");
+        return Status::OK;
+    }
+
+    // Frame streams: the first frame, and any frame where most tiles
+    // changed, is read in full. Later frames only have the regions around
+    // changed tiles recognized, on the worker pool in parallel, and an update
+    // is streamed back only when the text changed.
+    Status ProcessFrames(ServerContext* context,
+                         ServerReaderWriter<FrameTextUpdate, Frame>* stream) override {
+        Frame frame;
+        Pix* previous_pix = nullptr;
+        std::vector<FrameWord> words;
+        uint64_t frame_count = 0;
+
+        while (stream->Read(&frame)) {
+            const uint64_t frame_index = frame.frame_index() ? frame.frame_index() : frame_count;
+            ++frame_count;
+            stats_.local().frames_received++;
+
+            const RecognitionProfile* profile = profiles_.find(frame.profile());
+            if (!profile) {
+                pixDestroy(&previous_pix);
+                return Status(grpc::StatusCode::INVALID_ARGUMENT,
+                              "Unknown recognition profile: " + frame.profile());
+            }
+            Status readiness = checkReady(*profile);
+            if (!readiness.ok()) {
+                pixDestroy(&previous_pix);
+                return readiness;
+            }
+            std::string decode_error;
+            Pix* image_pix = decodeLimitedImage(frame.image(), image_limits_, stats_.local(), decode_error);
+            Pix* current_pix = image_pix ? pixConvertTo8(image_pix, 0) : nullptr;
+            pixDestroy(&image_pix);
+            if (!current_pix) {
+                std::cout << "[Server] Skipping undecodable frame " << frame_index
+                          << (decode_error.empty() ? "" : " (" + decode_error + ")") << std::endl;
+                continue;
+            }
+            const int width = pixGetWidth(current_pix);
+            const int height = pixGetHeight(current_pix);
+
+            FrameTextUpdate update;
+            update.set_frame_index(frame_index);
+            std::vector<FrameRegion> regions;
+            size_t changed_tiles = 0, total_tiles = 0;
+            bool full_frame = !previous_pix || pixGetWidth(previous_pix) != width ||
+                              pixGetHeight(previous_pix) != height;
+            if (!full_frame) {
+                regions = changedFrameRegions(previous_pix, current_pix, changed_tiles, total_tiles);
+                full_frame = changed_tiles > kFrameFullRescanRatio * total_tiles;
+            }
+            if (full_frame) {
+                regions.assign(1, FrameRegion{0, 0, width, height});
+                total_tiles = static_cast<size_t>((width + kFrameTileSize - 1) / kFrameTileSize) *
+                              ((height + kFrameTileSize - 1) / kFrameTileSize);
+                changed_tiles = total_tiles;
+            } else {
+                settleFrameRegions(regions, words, width, height);
+            }
+            update.set_changed_tiles(static_cast<uint32_t>(changed_tiles));
+            update.set_total_tiles(static_cast<uint32_t>(total_tiles));
+            pixDestroy(&previous_pix);
+            previous_pix = current_pix;
+
+            if (regions.empty()) {
+                stats_.local().frames_unchanged++;
+                continue;
+            }
+
+            std::vector<std::vector<FrameWord>> region_words;
+            if (!recognizeFrameRegions(current_pix, regions, *profile, region_words)) {
+                pixDestroy(&previous_pix);
+                return Status(grpc::StatusCode::DEADLINE_EXCEEDED, "Frame recognition timed out");
+            }
+
+            for (size_t i = 0; i < regions.size(); ++i) {
+                const FrameRegion& region = regions[i];
+                std::vector<FrameWord> previous_words;
+                for (auto it = words.begin(); it != words.end();) {
+                    if (full_frame || region.contains(*it)) {
+                        previous_words.push_back(std::move(*it));
+                        it = words.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                words.insert(words.end(), region_words[i].begin(), region_words[i].end());
+
+                std::string previous_text = frameWordsText(previous_words);
+                std::string text = frameWordsText(region_words[i]);
+                if (previous_text == text) continue;
+                TextChange* change = update.add_changes();
+                change->set_x(region.x);
+                change->set_y(region.y);
+                change->set_width(region.width);
+                change->set_height(region.height);
+                change->set_previous_text(previous_text);
+                change->set_text(text);
+            }
+
+            if (update.changes_size() == 0) {
+                stats_.local().frames_unchanged++;
+                continue;
+            }
+            update.set_text(frameWordsText(words));
+            if (!stream->Write(update)) break;
+        }
+
+        pixDestroy(&previous_pix);
+        std::cout << "[Server] Frame stream closed after " << frame_count << " frames" << std::endl;
+        return Status::OK;
+    }
+
+    Status GetStats(ServerContext* context,
+                    const StatsRequest* request,
+                    StatsResponse* response) override {
+        stats_.fillResponse(response);
+        return Status::OK;
+    }
+
+    Status StealTasks(ServerContext* context,
+                      const StealTasksRequest* request,
+                      StealTasksResponse* response) override {
+        if (request->max_tasks() <= 0) return Status::OK;
+        for (const auto& task : task_processor_.donateTasks(request->max_tasks(), request->thief())) {
+            StolenTask* stolen = response->add_tasks();
+            stolen->set_task_id(task->task_id);
+            stolen->set_filename(task->file_name);
+            stolen->set_lang(task->language_code);
+            stolen->set_profile(task->profile_name);
+            stolen->set_want_word_boxes(task->want_word_boxes);
+            stolen->set_priority(task->interactive ? ocr::PRIORITY_INTERACTIVE : ocr::PRIORITY_BULK);
+            stolen->set_image(task->image_data.data(), task->image_data.size());
+            std::cout << "[Steal] Lent " << task->file_name << " to "
+                      << request->thief() << std::endl;
+        }
+        return Status::OK;
+    }
+
+    Status CompleteStolenTask(ServerContext* context,
+                              const StolenTaskResult* request,
+                              StolenTaskAck* response) override {
+        response->set_accepted(task_processor_.completeLoanedTask(
+            request->task_id(), request->thief(), request->text(), request->failed(),
+            request->word_boxes()));
+        return Status::OK;
+    }
+
+private:
+    struct ContentKeys {
+        std::string cache_key;
+        bool has_perceptual_hash = false;
+        uint64_t perceptual_hash = 0;
+    };
+
+    // Header-only check, before anything decodes or queues the image.
+    bool admitImage(const ProcessImageRequest& request, std::string& error) {
+        int reduction = 1;
+        if (checkImageLimits(reinterpret_cast<const l_uint8*>(request.image().data()),
+                             request.image().size(), image_limits_, reduction, error)) {
+            return true;
+        }
+        stats_.local().images_oversize++;
+        std::cout << "[Server] Refused image " << request.filename() << ": " << error << std::endl;
+        return false;
+    }
+
+    // The perceptual hash needs a decode here in the handler, on top of the
+    // worker's; it is only computed when the near-duplicate index is on.
+    ContentKeys computeKeys(const ProcessImageRequest& request, const RecognitionProfile& profile) {
+        ContentKeys keys;
+        keys.cache_key = ResultCache::makeKey(profile.name, request.image());
+        if (near_duplicates_.enabled()) {
+            keys.has_perceptual_hash = perceptualHash(request.image(), image_limits_, stats_.local(),
+                                                      keys.perceptual_hash);
+        }
+        return keys;
+    }
+
+    std::shared_ptr<OcrTask> createTask(const ProcessImageRequest& request,
+                                        const RecognitionProfile& profile,
+                                        const ContentKeys& keys,
+                                        const std::string& job_id) {
+        auto task = std::make_shared<OcrTask>();
+        task->job_id = job_id;
+        task->cache_key = keys.cache_key;
+        task->has_perceptual_hash = keys.has_perceptual_hash;
+        task->perceptual_hash = keys.perceptual_hash;
+        if (!request.batch_id().empty()) {
+            task->batch_key = request.client_id() + "/" + request.batch_id();
+        }
+        task->batch_id = request.batch_id();
+        task->file_name = request.filename();
+        // Recognition runs the profile's language (or the one OSD picks), not
+        // request.lang(), so the cost model and the journal use it too.
+        task->language_code = profile.language;
+        task->profile_name = profile.name;
+        task->want_word_boxes = request.want_word_boxes();
+        task->form_template = request.form_template();
+        task->interactive = request.priority() != ocr::PRIORITY_BULK;
+        task->task_start_time = std::chrono::steady_clock::now();
+        task->image_data.assign(request.image().begin(), request.image().end());
+        return task;
+    }
+
+    static TaskJournal::PendingEntry journalEntryFor(const OcrTask& task) {
+        TaskJournal::PendingEntry entry;
+        entry.job_id = task.job_id;
+        entry.file_name = task.file_name;
+        entry.language_code = task.language_code;
+        entry.profile_name = task.profile_name;
+        entry.batch_id = task.batch_id;
+        entry.batch_key = task.batch_key;
+        entry.cache_key = task.cache_key;
+        entry.form_template = task.form_template;
+        entry.want_word_boxes = task.want_word_boxes;
+        entry.interactive = task.interactive;
+        entry.has_perceptual_hash = task.has_perceptual_hash;
+        entry.perceptual_hash = task.perceptual_hash;
+        return entry;
+    }
+
+    // Journals the task before queueing it, so an accepted task survives a
+    // crash from this point on.
+    bool acceptTask(const std::shared_ptr<OcrTask>& task) {
+        jobs_.markPending(task->job_id);
+        if (journal_.enabled() && !journal_.recordAccepted(journalEntryFor(*task), task->image_data)) {
+            std::cerr << "[WAL] Failed to journal task: " << task->file_name << std::endl;
+            jobs_.markFinished(task->job_id, "", true, 0);
+            return false;
+        }
+        task_processor_.submitTask(task);
+        return true;
+    }
+
+    static void fillAllocationProfile(const OcrTask& task, AllocationProfile* profile) {
+        for (size_t stage = 0; stage < kAllocationStages; ++stage) {
+            const AllocationSample& sample = task.allocation_stages[stage];
+            StageAllocation* entry = profile->add_stages();
+            entry->set_stage(kAllocationStageNames[stage]);
+            entry->set_allocations(sample.allocations);
+            entry->set_bytes(sample.bytes);
+            entry->set_peak_live_bytes(sample.peak_live_bytes);
+        }
+        profile->set_peak_live_bytes(task.allocation_peak_bytes);
+    }
+
+    // Exact content match first, then the nearest earlier page within the
+    // configured perceptual-hash distance.
+    bool serveFromCache(const ProcessImageRequest& request, const RecognitionProfile& profile,
+                        const ContentKeys& keys, const std::string& job_id,
+                        ProcessImageResponse* response) {
+        // The caches hold whole-page text only; requests for geometry or
+        // template fields must recognize.
+        if (request.want_word_boxes() || !request.form_template().empty()) return false;
+
+        std::string cached_text;
+        int distance = 0;
+        if (cache_.lookup(keys.cache_key, cached_text)) {
+            stats_.local().cache_hits++;
+        } else if (keys.has_perceptual_hash &&
+                   near_duplicates_.find(profile.name, keys.perceptual_hash, cached_text, distance)) {
+            stats_.local().cache_misses++;
+            stats_.local().near_duplicate_hits++;
+            response->set_near_duplicate(true);
+            response->set_near_duplicate_distance(distance);
+            std::cout << "[Server] Near-duplicate (distance " << distance << ") for image: "
+                      << request.filename() << std::endl;
+        } else {
+            stats_.local().cache_misses++;
+            return false;
+        }
+        jobs_.markFinished(job_id, cached_text, false, 0);
+        if (text_index_.enabled()) {
+            text_index_.addDocument(job_id, request.batch_id(), request.filename(), cached_text);
+            stats_.local().indexed_documents = text_index_.documentCount();
+        }
+        response->set_ok(true);
+        response->set_text(cached_text);
+        response->set_cached(true);
+        response->set_processing_time_ms(0);
+        std::cout << "[Server] Cache hit for image: " << request.filename() << std::endl;
+        return true;
+    }
+
+    // Crops each region out of the frame and queues it as its own task with
+    // word boxes, then maps the words back to frame coordinates.
+    bool recognizeFrameRegions(Pix* frame_pix, const std::vector<FrameRegion>& regions,
+                               const RecognitionProfile& profile,
+                               std::vector<std::vector<FrameWord>>& region_words) {
+        std::vector<std::shared_ptr<OcrTask>> tasks;
+        std::vector<std::future<std::string>> results;
+        for (const FrameRegion& region : regions) {
+            auto task = std::make_shared<OcrTask>();
+            task->file_name = "frame-region";
+            task->language_code = profile.language;
+            task->keep_orientation = true;
+            task->profile_name = profile.name;
+            task->want_word_boxes = true;
+            task->task_start_time = std::chrono::steady_clock::now();
+
+            Box* box = boxCreate(region.x, region.y, region.width, region.height);
+            Pix* region_pix = pixClipRectangle(frame_pix, box, nullptr);
+            boxDestroy(&box);
+            l_uint8* encoded = nullptr;
+            size_t encoded_size = 0;
+            if (region_pix && pixWriteMem(&encoded, &encoded_size, region_pix, IFF_PNM) == 0) {
+                task->image_data.assign(encoded, encoded + encoded_size);
+            }
+            lept_free(encoded);
+            pixDestroy(&region_pix);
+
+            results.push_back(task->text_promise.get_future());
+            tasks.push_back(task);
+            task_processor_.submitTask(task);
+        }
+        stats_.local().frame_regions_recognized += regions.size();
+
+        region_words.assign(regions.size(), {});
+        for (size_t i = 0; i < regions.size(); ++i) {
+            if (results[i].wait_for(std::chrono::seconds(120)) == std::future_status::timeout) {
+                stats_.local().tasks_timed_out++;
+                return false;
+            }
+            std::string text = results[i].get();
+            if (tasks[i]->failed) continue;
+            appendFrameWords(text, tasks[i]->word_boxes, regions[i].x, regions[i].y, region_words[i]);
+        }
+        return true;
+    }
+
+    static constexpr size_t kMaxArchiveEntryBytes = 64 * 1024 * 1024;
+    static constexpr size_t kMaxArchiveEntriesInFlight = 64;
+    // Requests for a profile no worker has warmed are refused at once with
+    // UNAVAILABLE rather than holding an RPC thread through warm-up.
+    Status checkReady(const RecognitionProfile& profile) {
+        switch (task_processor_.profileReadiness(profile.name)) {
+        case TaskProcessor::ProfileReadiness::Ready:
+            return Status::OK;
+        case TaskProcessor::ProfileReadiness::WarmingUp:
+            return Status(grpc::StatusCode::UNAVAILABLE, "Server not ready: OCR engines warming up");
+        default:
+            return Status(grpc::StatusCode::UNAVAILABLE,
+                          "Recognition profile unavailable: no worker has a usable engine for " +
+                          profile.name);
+        }
+    }
+
+    // Shared with the completion callbacks of queued archive entries, which
+    // may outlive the call when the client goes away.
+    struct ArchiveProgress {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<ArchiveEntryResult> ready;
+        size_t in_flight = 0;
+        bool input_done = false;
+        bool cancelled = false;
+
+        bool isCancelled() {
+            std::lock_guard<std::mutex> guard(mutex);
+            return cancelled;
+        }
+
+        void publish(ArchiveEntryResult result, bool finished_task) {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                ready.push_back(std::move(result));
+                if (finished_task) in_flight--;
+            }
+            changed.notify_all();
+        }
+    };
+
+    // Answers the entry from the caches or queues it. Returns false when the
+    // call was cancelled while waiting for a free in-flight slot.
+    bool submitArchiveEntry(const std::shared_ptr<ArchiveProgress>& progress,
+                            const ProcessImageRequest& entry_template,
+                            const RecognitionProfile& profile, uint32_t entry_index,
+                            ArchiveReader::Entry& entry) {
+        stats_.local().archive_entries++;
+        ArchiveEntryResult result;
+        result.set_entry_index(entry_index);
+        result.set_filename(entry.name);
+        if (!entry.error.empty()) {
+            result.mutable_result()->set_ok(false);
+            result.mutable_result()->set_message(entry.error);
+            progress->publish(std::move(result), false);
+            return true;
+        }
+
+        ProcessImageRequest request = entry_template;
+        request.set_filename(entry.name);
+        request.set_image(std::move(entry.data));
+        std::string image_error;
+        if (!admitImage(request, image_error)) {
+            result.mutable_result()->set_ok(false);
+            result.mutable_result()->set_message(image_error);
+            progress->publish(std::move(result), false);
+            return true;
+        }
+        const std::string job_id = jobs_.newJobId();
+        const ContentKeys keys = computeKeys(request, profile);
+        if (serveFromCache(request, profile, keys, job_id, result.mutable_result())) {
+            progress->publish(std::move(result), false);
+            return true;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(progress->mutex);
+            progress->changed.wait(lock, [&] {
+                return progress->cancelled || progress->in_flight < kMaxArchiveEntriesInFlight;
+            });
+            if (progress->cancelled) return false;
+            progress->in_flight++;
+        }
+
+        auto task = createTask(request, profile, keys, job_id);
+        task->on_complete = [progress, result](const OcrTask& finished, const std::string& text) {
+            ArchiveEntryResult entry_result = result;
+            ProcessImageResponse* response = entry_result.mutable_result();
+            response->set_ok(!finished.failed);
+            response->set_text(text);
+            response->set_job_id(finished.job_id);
+            if (finished.failed) response->set_message("Image processing failed");
+            response->set_processing_time_ms(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - finished.task_start_time).count());
+            progress->publish(std::move(entry_result), true);
+        };
+        if (!acceptTask(task)) {
+            result.mutable_result()->set_ok(false);
+            result.mutable_result()->set_message("Failed to journal task");
+            progress->publish(std::move(result), true);
+        }
+        return true;
+    }
+
+    static void fillFromJob(const JobRecord& record, ProcessImageResponse* response) {
+        response->set_ok(!record.failed);
+        response->set_text(record.text);
+        response->set_processing_time_ms(record.processing_time_ms);
+        if (record.word_boxes.confidences_size() > 0) {
+            *response->mutable_word_boxes() = record.word_boxes;
+        }
+        if (record.failed) response->set_message("Image processing failed");
+    }
+
+    TaskProcessor &task_processor_;
+    const ProfileCatalog &profiles_;
+    ResultCache &cache_;
+    NearDuplicateIndex &near_duplicates_;
+    JobStore &jobs_;
+    TaskJournal &journal_;
+    TextIndex &text_index_;
+    TemplateRegistry &templates_;
+    FaultInjector &faults_;
+    bool fault_injection_;
+    ImageLimits image_limits_;
+    RequestCapture &capture_;
+    StatsRegistry &stats_;
+};
+
+// SERVER PROCESS -------------------------------------------------------------
+static int runServer(const ServerOptions& options, StatsRegistry& stats) {
+    installShutdownHandlers();
+
+    ProfileCatalog profiles;
+    if (!options.profiles_path.empty() && !profiles.loadFile(options.profiles_path)) {
+        std::cerr << "Failed to read profiles file " << options.profiles_path
+                  << ", using built-in profiles only.\n";
+    }
+
+    EngineRecyclePolicy recycle_policy;
+    recycle_policy.max_tasks = options.recycle_after_tasks;
+    recycle_policy.max_growth_bytes = options.recycle_above_rss_mb * 1024 * 1024;
+
+    OsdOptions osd;
+    osd.enabled = options.osd_enabled;
+    osd.script_languages = options.osd_script_languages;
+
+    TemplateRegistry templates(options.template_directory);
+
+    FaultInjector faults;
+    std::string fault_error;
+    if (!faults.setRules(options.fault_rules, fault_error)) {
+        std::cerr << "[Fault] " << fault_error << std::endl;
+        return 1;
+    }
+
+    ResultCache tile_cache(options.tile_cache_entries);
+
+    SchedulingPolicy scheduling;
+    scheduling.reserved_interactive = options.interactive_workers;
+    scheduling.parallel_preprocess_mp = options.parallel_preprocess_mp;
+    scheduling.max_strips = stripBudget(options.worker_threads, options.process_count);
+    scheduling.shortest_first = options.shortest_job_first;
+    scheduling.aging = std::chrono::milliseconds(options.sjf_aging_ms);
+    scheduling.max_eta = std::chrono::milliseconds(options.max_queue_eta_ms);
+    scheduling.loan_lease = std::chrono::seconds(options.steal_lease_seconds);
+
+    ImageLimits image_limits;
+    image_limits.max_pixels = options.max_image_megapixels * 1000000;
+    image_limits.max_decoded_bytes = options.max_decoded_mb * 1024 * 1024;
+    image_limits.downsample = options.downsample_oversize;
+
+    // Everything the completion listener touches is built before the
+    // processor starts its workers, so it outlives them on every return path.
+    ResultCache cache(options.cache_entries);
+    NearDuplicateIndex near_duplicates(options.near_duplicate_distance,
+                                       options.near_duplicate_entries);
+    JobStore jobs(options.job_results, stats.localIndex());
+
+    TextIndex text_index(options.index_directory.empty() ? "" :
+        options.index_directory + "/slot-" + std::to_string(stats.localIndex()));
+    if (text_index.enabled()) {
+        if (!text_index.open()) {
+            std::cerr << "[Index] Cannot open full-text index in " << options.index_directory << std::endl;
+            return 1;
+        }
+        stats.local().indexed_documents = text_index.documentCount();
+    }
+
+    // Prefork children each journal into their own slot directory.
+    TaskJournal journal(options.wal_directory.empty() ? "" :
+        options.wal_directory + "/slot-" + std::to_string(stats.localIndex()));
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    if (journal.enabled() && !journal.recover(pending, finished, options.job_results)) {
+        std::cerr << "[WAL] Cannot open write-ahead log in " << options.wal_directory << std::endl;
+        return 1;
+    }
+
+    // Prefork children each write their own file, suffixed with the slot.
+    RequestCapture capture(options.process_count > 1
+                               ? options.capture_path + "." + std::to_string(stats.localIndex())
+                               : options.capture_path,
+                           options.capture_sample_rate, stats.local());
+    if (!options.capture_path.empty()) {
+        if (!capture.open()) {
+            std::cerr << "[Server] Failed to open capture file: " << options.capture_path << std::endl;
+            return 1;
+        }
+        std::cout << "[Server] Capturing requests, keeping " << options.capture_sample_rate * 100.0
+                  << "% of payloads" << std::endl;
+    }
+
+    if (!options.shadow_profile.empty() && options.shadow_sample_rate > 0.0 &&
+        !profiles.find(options.shadow_profile)) {
+        std::cerr << "[Shadow] Unknown shadow profile: " << options.shadow_profile << std::endl;
+        return 1;
+    }
+
+    TaskProcessor processor(options.worker_threads, options.tessdata_path,
+                            profiles, recycle_policy, osd, templates, faults, tile_cache,
+                            scheduling, image_limits, stats.local());
+    // Declared after the processor and so destroyed first: any return from
+    // here on stops the processor before the mirror goes away.
+    ShadowMirror shadow(processor, options.shadow_profile, options.shadow_sample_rate,
+                        stats.local());
+
+    processor.setCompletionListener([&](const OcrTask& task, const std::string& text) {
+        if (task.shadow) return;
+        shadow.maybeMirror(task, text);
+        // Template field text is not a whole-page result; keep it out of the caches.
+        const bool cacheable = !task.failed && !task.template_matched;
+        if (cacheable && !task.cache_key.empty()) cache.insert(task.cache_key, text);
+        if (cacheable && task.has_perceptual_hash) {
+            near_duplicates.insert(task.profile_name, task.perceptual_hash, text);
+        }
+        if (task.job_id.empty()) return;
+        long long processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - task.task_start_time).count();
+        jobs.markFinished(task.job_id, text, task.failed, processing_time,
+                          task.want_word_boxes ? &task.word_boxes : nullptr);
+        journal.recordFinished(task.job_id, text, task.failed);
+        if (text_index.enabled() && !task.failed) {
+            text_index.addDocument(task.job_id, task.batch_id, task.file_name, text);
+            stats.local().indexed_documents = text_index.documentCount();
+        }
+    });
+
+    if (journal.enabled()) {
+        for (const auto& entry : finished) {
+            jobs.markFinished(entry.job_id, entry.text, entry.failed, 0);
+        }
+        for (const auto& entry : pending) {
+            auto task = std::make_shared<OcrTask>();
+            task->job_id = entry.job_id;
+            task->file_name = entry.file_name;
+            task->batch_id = entry.batch_id;
+            task->batch_key = entry.batch_key;
+            task->cache_key = entry.cache_key;
+            task->form_template = entry.form_template;
+            task->want_word_boxes = entry.want_word_boxes;
+            task->interactive = entry.interactive;
+            task->has_perceptual_hash = entry.has_perceptual_hash;
+            task->perceptual_hash = entry.perceptual_hash;
+            task->task_start_time = std::chrono::steady_clock::now();
+            const RecognitionProfile* profile = profiles.find(entry.profile_name);
+            if (!profile || !journal.loadPayload(entry.job_id, task->image_data)) {
+                std::cerr << "[WAL] Dropping unrecoverable task: " << entry.file_name << std::endl;
+                jobs.markFinished(entry.job_id, "", true, 0);
+                journal.recordFinished(entry.job_id, "", true);
+                continue;
+            }
+            task->profile_name = profile->name;
+            task->language_code = profile->language;
+            jobs.markPending(task->job_id);
+            processor.submitTask(task);
+            stats.local().tasks_replayed++;
+        }
+        std::cout << "[WAL] Replayed " << stats.local().tasks_replayed.load()
+                  << " pending tasks and " << finished.size() << " finished results" << std::endl;
+    }
+
+    OCRServiceHandler handler(processor, profiles, cache, near_duplicates, jobs, journal,
+                              text_index, templates, faults, options.fault_injection, image_limits,
+                              capture, stats);
+
+    // Every process binds the same endpoint; the kernel spreads incoming
+    // connections across them through SO_REUSEPORT.
+    // grpc.health.v1 reports NOT_SERVING until the workers are warm.
+    grpc::EnableDefaultHealthCheckService(true);
+    ServerBuilder builder;
+    builder.AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 1);
+    builder.AddListeningPort(options.endpoint, grpc::InsecureServerCredentials());
+    builder.RegisterService(&handler);
+
+    std::unique_ptr<Server> server(builder.BuildAndStart());
+    if (!server) {
+        std::cerr << "[Server " << getpid() << "] Failed to listen on "
+                  << options.endpoint << std::endl;
+        processor.stopProcessing();
+        return 1;
+    }
+    std::cout << "OCR Server running at " << options.endpoint
+              << " with " << options.worker_threads << " workers (pid "
+              << getpid() << ").\n";
+
+    grpc::HealthCheckServiceInterface* health = server->GetHealthCheckService();
+    if (health) health->SetServingStatus(false);
+
+    PeerStealer stealer(processor, profiles, options, stats.local());
+
+    // The server serves once any worker is warm; each profile is reported
+    // as its own health service, "ocr.profile.<name>".
+    std::thread readiness_watcher([&] {
+        bool serving = false;
+        while (!shutdown_signal_received) {
+            const bool finished = processor.waitForWarmUp(std::chrono::milliseconds(200));
+            if (shutdown_signal_received) return;
+            std::vector<std::string> unavailable;
+            for (const auto& entry : profiles.all()) {
+                auto readiness = processor.profileReadiness(entry.first);
+                if (readiness == TaskProcessor::ProfileReadiness::Unavailable) unavailable.push_back(entry.first);
+                if (health) {
+                    health->SetServingStatus("ocr.profile." + entry.first,
+                                             readiness == TaskProcessor::ProfileReadiness::Ready);
+                }
+            }
+            if (!serving && processor.readyWorkerCount() > 0) {
+                serving = true;
+                if (health) health->SetServingStatus(true);
+                std::cout << "[Server " << getpid() << "] Ready: "
+                          << stats.local().workers_ready.load() << " of " << options.worker_threads
+                          << " workers warm" << std::endl;
+            }
+            if (!finished) continue;
+            for (const std::string& name : unavailable) {
+                std::cerr << "[Server " << getpid() << "] No worker has a usable engine for profile "
+                          << name << ", reporting it NOT_SERVING" << std::endl;
+            }
+            if (!serving) {
+                std::cerr << "[Server " << getpid() << "] No worker has usable OCR engines, "
+                          << "reporting NOT_SERVING" << std::endl;
+            }
+            return;
+        }
+    });
+
+    std::thread shutdown_watcher([&server, health] {
+        while (!shutdown_signal_received) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        if (health) health->SetServingStatus(false);
+        server->Shutdown();
+    });
+
+    server->Wait();
+    processor.stopProcessing();
+    shutdown_signal_received = 1;
+    readiness_watcher.join();
+    shutdown_watcher.join();
+    return 0;
+}
+//----------------------------------------------------------------------------
+
+// PREFORK SUPERVISOR -------------------------------------------------------
+// Forks one server process per stats slot, restarts any that exit
+// unexpectedly and periodically prints the aggregated stats.
+// A child that exits within kFastExitSeconds of starting (bad flag, port in
+// use, unreadable directory) is restarted after an exponentially growing
+// delay; after kMaxFastExits such exits in a row its slot is abandoned, and
+// the supervisor exits once every slot is.
+static constexpr int kFastExitSeconds = 10;
+static constexpr int kMaxFastExits = 5;
+static constexpr int kMaxRestartDelaySeconds = 30;
+
+static int runPreforkSupervisor(const ServerOptions& options) {
+    StatsRegistry stats(options.process_count);
+    struct Slot {
+        pid_t pid = -1;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point restart_at;
+        int fast_exits = 0;
+        bool abandoned = false;
+    };
+    std::vector<Slot> children(options.process_count);
+
+    auto spawn_child = [&](size_t index) {
+        Slot& slot = children[index];
+        slot.started = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "[Supervisor] fork failed for slot " << index << std::endl;
+            slot.restart_at = slot.started + std::chrono::seconds(1);
+            return;
+        }
+        if (pid == 0) {
+            stats.setLocalIndex(index);
+            std::_Exit(runServer(options, stats));
+        }
+        slot.pid = pid;
+        std::cout << "[Supervisor] Started server process " << pid
+                  << " (slot " << index << ")" << std::endl;
+    };
+
+    installShutdownHandlers();
+    for (size_t i = 0; i < children.size(); ++i) spawn_child(i);
+
+    auto last_report = std::chrono::steady_clock::now();
+    while (!shutdown_signal_received) {
+        int status = 0;
+        pid_t exited = waitpid(-1, &status, WNOHANG);
+        auto now = std::chrono::steady_clock::now();
+        if (exited > 0) {
+            for (size_t i = 0; i < children.size(); ++i) {
+                Slot& slot = children[i];
+                if (slot.pid != exited) continue;
+                stats.releaseSlot(i);
+                slot.pid = -1;
+                bool fast = now - slot.started < std::chrono::seconds(kFastExitSeconds);
+                slot.fast_exits = fast ? slot.fast_exits + 1 : 0;
+                if (slot.fast_exits >= kMaxFastExits) {
+                    slot.abandoned = true;
+                    std::cerr << "[Supervisor] Server process " << exited << " exited "
+                              << slot.fast_exits << " times right after starting, giving up on slot "
+                              << i << std::endl;
+                    continue;
+                }
+                int delay = slot.fast_exits == 0
+                    ? 0 : std::min(kMaxRestartDelaySeconds, 1 << (slot.fast_exits - 1));
+                slot.restart_at = now + std::chrono::seconds(delay);
+                std::cerr << "[Supervisor] Server process " << exited << " exited, restarting slot "
+                          << i << " in " << delay << " s" << std::endl;
+            }
+            continue;
+        }
+
+        bool any_alive = false;
+        for (size_t i = 0; i < children.size(); ++i) {
+            Slot& slot = children[i];
+            if (slot.abandoned) continue;
+            any_alive = true;
+            if (slot.pid < 0 && now >= slot.restart_at) spawn_child(i);
+        }
+        if (!any_alive) {
+            std::cerr << "[Supervisor] Every server slot was abandoned, exiting" << std::endl;
+            stats.printSummary("[Supervisor] Final stats:");
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        now = std::chrono::steady_clock::now();
+        if (options.stats_interval_seconds > 0 &&
+            now - last_report >= std::chrono::seconds(options.stats_interval_seconds)) {
+            stats.printSummary("[Supervisor] Stats:");
+            last_report = now;
+        }
+    }
+
+    std::cout << "[Supervisor] Shutting down " << children.size() << " server processes\n";
+    for (const Slot& slot : children) {
+        if (slot.pid > 0) kill(slot.pid, SIGTERM);
+    }
+    for (const Slot& slot : children) {
+        if (slot.pid > 0) waitpid(slot.pid, nullptr, 0);
+    }
+    stats.printSummary("[Supervisor] Final stats:");
+    return 0;
+}
+//----------------------------------------------------------------------------
+
+// OPTIONS --------------------------------------------------------------------
+static bool readFlag(const std::string& arg, const std::string& name, std::string& value) {
+    const std::string prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+static std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static ServerOptions parseOptions(int argc, char** argv) {
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        try {
+            if (readFlag(arg, "workers", value)) {
+                options.worker_threads = std::stoul(value);
+            } else if (readFlag(arg, "endpoint", value)) {
+                options.endpoint = value;
+            } else if (readFlag(arg, "processes", value)) {
+                options.process_count = std::max<size_t>(1, std::stoul(value));
+            } else if (readFlag(arg, "stats-interval", value)) {
+                options.stats_interval_seconds = std::stoi(value);
+            } else if (readFlag(arg, "tessdata", value)) {
+                options.tessdata_path = value;
+            } else if (readFlag(arg, "profiles", value)) {
+                options.profiles_path = value;
+            } else if (readFlag(arg, "recycle-tasks", value)) {
+                options.recycle_after_tasks = std::stoul(value);
+            } else if (readFlag(arg, "recycle-rss-mb", value)) {
+                options.recycle_above_rss_mb = std::stoul(value);
+            } else if (readFlag(arg, "cache-entries", value)) {
+                options.cache_entries = std::stoul(value);
+            } else if (readFlag(arg, "schedule", value)) {
+                if (value != "fifo" && value != "sjf") {
+                    throw std::invalid_argument("--schedule must be fifo or sjf");
+                }
+                options.shortest_job_first = value == "sjf";
+            } else if (readFlag(arg, "sjf-aging-ms", value)) {
+                options.sjf_aging_ms = std::stoll(value);
+            } else if (readFlag(arg, "parallel-preprocess-mp", value)) {
+                options.parallel_preprocess_mp = std::stod(value);
+            } else if (readFlag(arg, "interactive-workers", value)) {
+                options.interactive_workers = std::stoul(value);
+            } else if (readFlag(arg, "max-queue-eta-ms", value)) {
+                options.max_queue_eta_ms = std::stoll(value);
+            } else if (readFlag(arg, "tile-cache-entries", value)) {
+                options.tile_cache_entries = std::stoul(value);
+            } else if (readFlag(arg, "peers", value)) {
+                options.peer_endpoints = splitList(value);
+            } else if (readFlag(arg, "steal-lease", value)) {
+                options.steal_lease_seconds = std::stoi(value);
+            } else if (readFlag(arg, "wal-dir", value)) {
+                options.wal_directory = value;
+            } else if (readFlag(arg, "job-results", value)) {
+                options.job_results = std::stoul(value);
+            } else if (readFlag(arg, "near-dup-distance", value)) {
+                options.near_duplicate_distance = std::stoi(value);
+            } else if (readFlag(arg, "near-dup-entries", value)) {
+                options.near_duplicate_entries = std::stoul(value);
+            } else if (readFlag(arg, "index-dir", value)) {
+                options.index_directory = value;
+            } else if (readFlag(arg, "shadow-profile", value)) {
+                options.shadow_profile = value;
+            } else if (readFlag(arg, "shadow-sample", value)) {
+                options.shadow_sample_rate = std::stod(value);
+            } else if (arg == "--fault-injection") {
+                options.fault_injection = true;
+            } else if (readFlag(arg, "inject", value)) {
+                options.fault_injection = true;
+                options.fault_rules = splitList(value);
+            } else if (readFlag(arg, "template-dir", value)) {
+                options.template_directory = value;
+            } else if (readFlag(arg, "max-image-mp", value)) {
+                options.max_image_megapixels = std::stoull(value);
+            } else if (readFlag(arg, "max-decoded-mb", value)) {
+                options.max_decoded_mb = std::stoull(value);
+            } else if (readFlag(arg, "oversize", value)) {
+                if (value != "reject" && value != "downsample") {
+                    throw std::invalid_argument("--oversize must be reject or downsample");
+                }
+                options.downsample_oversize = value == "downsample";
+            } else if (readFlag(arg, "capture", value)) {
+                options.capture_path = value;
+            } else if (readFlag(arg, "capture-sample", value)) {
+                options.capture_sample_rate = std::stod(value);
+            } else if (arg == "--alloc-profile") {
+#ifdef OCR_ALLOC_PROFILE
+                options.allocation_profiling = true;
+#else
+                std::cerr << "Ignoring --alloc-profile: build with -DOCR_ALLOC_PROFILE=ON to use it\n";
+#endif
+            } else if (arg == "--osd") {
+                options.osd_enabled = true;
+            } else if (readFlag(arg, "osd-scripts", value)) {
+                options.osd_enabled = true;
+                options.osd_script_languages.clear();
+                for (const std::string& pair : splitList(value)) {
+                    size_t separator = pair.find(':');
+                    if (separator == std::string::npos) continue;
+                    options.osd_script_languages[pair.substr(0, separator)] = pair.substr(separator + 1);
+                }
+            } else if (i == 1 && arg.rfind("--", 0) != 0) {
+                options.worker_threads = std::stoul(arg);
+            } else {
+                std::cerr << "Ignoring unknown option: " << arg << "\n";
+            }
+        } catch (...) {
+            std::cerr << "Invalid value for " << arg << ", using default.\n";
+        }
+    }
+    return options;
+}
+//----------------------------------------------------------------------------
+
+// Replaceable global allocation functions, counted for --alloc-profile.
+// Only compiled in with OCR_ALLOC_PROFILE (the CMake option of that name),
+// so a default build keeps the C++ runtime's allocator untouched.
+#ifdef OCR_ALLOC_PROFILE
+// Like the library operator new: retry through the installed new_handler
+// until it frees memory, and throw only when there is none.
+static void* allocateOrThrow(size_t size, size_t alignment) {
+    while (true) {
+        void* block = alignment ? countedAlignedMalloc(size, alignment) : countedMalloc(size);
+        if (block) return block;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+static void* allocateOrNull(size_t size, size_t alignment) noexcept {
+    try {
+        return allocateOrThrow(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocateOrNull(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocateOrNull(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateOrNull(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateOrNull(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* block) noexcept { countedFree(block); }
+void operator delete[](void* block) noexcept { countedFree(block); }
+void operator delete(void* block, size_t) noexcept { countedFree(block); }
+void operator delete[](void* block, size_t) noexcept { countedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { countedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { countedFree(block); }
+void operator delete(void* block, std::align_val_t) noexcept { countedFree(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { countedFree(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { countedFree(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { countedFree(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(block); }
+#endif
+
+// Main Function --------------------------------------------------------------
+int main(int argc, char** argv) {
+    ServerOptions options = parseOptions(argc, argv);
+    // Before any engine exists, and inherited by prefork children.
+    if (options.allocation_profiling) enableAllocationProfiling();
+
+    if (options.process_count > 1) {
+        return runPreforkSupervisor(options);
+    }
+
+    StatsRegistry stats(1);
+    stats.setLocalIndex(0);
+    return runServer(options, stats);
 }
 //----------------------------------------------------------------------------
\ No newline at end of file
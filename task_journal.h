@@ -0,0 +1,336 @@
+#ifndef TASK_JOURNAL_H
+#define TASK_JOURNAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "content_hash.h"
+#include "record_file.h"
+
+// Accepted tasks are journaled before they are queued: the image is spilled
+// to payloads/<id>.img and an ACCEPT record is appended and fsync'ed. A DONE
+// record carrying the text follows when the task finishes. On restart,
+// ACCEPTs without a DONE are requeued and DONE results are served through
+// GetJobResult. The log is rewritten with only those records at startup and
+// again whenever it has doubled since (at least kMinCompactBytes).
+class TaskJournal {
+public:
+    // Everything needed to rebuild the request's OcrTask, minus the image.
+    struct PendingEntry {
+        std::string job_id;
+        std::string file_name;
+        std::string language_code;
+        std::string profile_name;
+        std::string batch_id;
+        std::string batch_key;
+        std::string cache_key;
+        std::string form_template;
+        bool want_word_boxes = false;
+        bool interactive = true;
+        bool has_perceptual_hash = false;
+        uint64_t perceptual_hash = 0;
+    };
+
+    struct FinishedEntry {
+        std::string job_id;
+        std::string text;
+        bool failed;
+    };
+
+    static constexpr long kMinCompactBytes = 64L * 1024 * 1024;
+
+    explicit TaskJournal(const std::string& directory, long min_compact_bytes = kMinCompactBytes)
+        : directory_(directory), log_(nullptr), keep_finished_(0),
+          min_compact_bytes_(min_compact_bytes), compact_at_(min_compact_bytes) {}
+
+    ~TaskJournal() {
+        if (log_) std::fclose(log_);
+    }
+
+    bool enabled() const { return !directory_.empty(); }
+
+    // Reads the existing log, rewrites it with only the records still needed
+    // (pending tasks and the newest keep_finished results) and reopens it
+    // for appending. Payloads of tasks that are no longer pending are
+    // removed.
+    bool recover(std::vector<PendingEntry>& pending, std::vector<FinishedEntry>& finished,
+                 size_t keep_finished) {
+        std::error_code error;
+        std::filesystem::create_directories(payloadDirectory(), error);
+        if (error) return false;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        keep_finished_ = keep_finished;
+        if (!rewriteLog(pending, finished)) return false;
+
+        std::unordered_map<std::string, bool> live_payloads;
+        for (const PendingEntry& entry : pending) live_payloads[payloadPath(entry.job_id)] = true;
+        for (std::filesystem::directory_iterator it(payloadDirectory(), error), end;
+             !error && it != end; it.increment(error)) {
+            if (!live_payloads.count(it->path().string())) {
+                std::error_code remove_error;
+                std::filesystem::remove(it->path(), remove_error);
+            }
+        }
+        return true;
+    }
+
+    enum class SiblingJob { Unknown, Pending, Finished };
+
+    // Looks a job up in the logs of the other prefork slots (sibling slot-*
+    // directories), for a client whose reconnect landed on another process.
+    // Each log is tailed from where the last lookup stopped and only record
+    // offsets are kept; a log rewritten by its owner is read again from the
+    // start.
+    SiblingJob findInSiblings(const std::string& job_id, FinishedEntry& result) {
+        std::filesystem::path own(directory_);
+        std::filesystem::path root = own.parent_path();
+        if (root.empty()) root = ".";
+        const std::string own_name = own.filename().string();
+
+        std::lock_guard<std::mutex> guard(sibling_mutex_);
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(root, error), end; !error && it != end;
+             it.increment(error)) {
+            const std::string name = it->path().filename().string();
+            if (name == own_name || name.compare(0, 5, "slot-") != 0) continue;
+            const std::string path = (it->path() / "tasks.wal").string();
+            SiblingLog& log = sibling_logs_[path];
+            if (!tailSibling(path, log)) continue;
+
+            auto done = log.finished.find(job_id);
+            if (done != log.finished.end()) {
+                std::ifstream input(path, std::ios::binary);
+                input.seekg(done->second);
+                char type = 0;
+                std::vector<std::string> fields;
+                if (readRecord(input, type, fields, 16) && type == 'D' && fields.size() == 3 &&
+                    fields[0] == job_id) {
+                    result = {fields[0], fields[2], fields[1] == "1"};
+                    return SiblingJob::Finished;
+                }
+            }
+            if (log.accepted.count(job_id)) return SiblingJob::Pending;
+        }
+        return SiblingJob::Unknown;
+    }
+
+    bool loadPayload(const std::string& job_id, std::vector<unsigned char>& image_data) const {
+        std::ifstream input(payloadPath(job_id), std::ios::binary);
+        if (!input.is_open()) return false;
+        image_data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool recordAccepted(const PendingEntry& entry, const std::vector<unsigned char>& image_data) {
+        if (!enabled()) return false;
+        const std::string path = payloadPath(entry.job_id);
+        const std::string temporary_path = path + ".tmp";
+        FILE* payload = std::fopen(temporary_path.c_str(), "wb");
+        if (!payload) return false;
+        bool written = std::fwrite(image_data.data(), 1, image_data.size(), payload)
+                       == image_data.size();
+        std::fflush(payload);
+        fsync(fileno(payload));
+        std::fclose(payload);
+        if (!written || std::rename(temporary_path.c_str(), path.c_str()) != 0) return false;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!log_) return false;
+        writeRecord(log_, 'A', acceptedFields(entry));
+        std::fflush(log_);
+        return fsync(fileno(log_)) == 0;
+    }
+
+    // The DONE record is fsync'ed before the payload is removed: an ACCEPT
+    // that survives a crash without its DONE must still find its image. If
+    // the sync fails the payload stays and the next recover() removes it.
+    void recordFinished(const std::string& job_id, const std::string& text, bool failed) {
+        if (!enabled()) return;
+        bool synced = false;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!log_) return;
+            writeRecord(log_, 'D', {job_id, failed ? "1" : "0", text});
+            std::fflush(log_);
+            synced = fsync(fileno(log_)) == 0;
+            if (std::ftell(log_) >= compact_at_) {
+                std::vector<PendingEntry> pending;
+                std::vector<FinishedEntry> finished;
+                rewriteLog(pending, finished);
+            }
+        }
+        if (synced) std::remove(payloadPath(job_id).c_str());
+    }
+
+private:
+    struct SiblingLog {
+        ino_t inode = 0;
+        std::streamoff offset = 0;
+        std::streamoff last_record = -1;
+        std::string last_job;
+        std::unordered_set<std::string> accepted;
+        std::unordered_map<std::string, std::streamoff> finished;  // job id -> DONE record
+    };
+
+    // Reads the records appended since the last call. A rewritten log is
+    // told apart by its inode, or, since a rewrite may reuse the inode of
+    // the log it replaced, by the last record read no longer being in
+    // place. Caller holds sibling_mutex_.
+    static bool tailSibling(const std::string& path, SiblingLog& log) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return false;
+        std::ifstream input(path, std::ios::binary);
+        if (!input.is_open()) return false;
+
+        char type = 0;
+        std::vector<std::string> fields;
+        bool same_log = info.st_ino == log.inode && info.st_size >= log.offset;
+        if (same_log && log.last_record >= 0) {
+            input.seekg(log.last_record);
+            same_log = readRecord(input, type, fields, 16) && !fields.empty() &&
+                       fields[0] == log.last_job;
+            input.clear();
+        }
+        if (!same_log) {
+            log = SiblingLog();
+            log.inode = info.st_ino;
+        }
+
+        input.seekg(log.offset);
+        while (readRecord(input, type, fields, 16)) {
+            if (type == 'A' && !fields.empty()) {
+                log.accepted.insert(fields[0]);
+            } else if (type == 'D' && fields.size() == 3) {
+                log.finished[fields[0]] = log.offset;
+            }
+            if (!fields.empty()) {
+                log.last_record = log.offset;
+                log.last_job = fields[0];
+            }
+            log.offset = input.tellg();
+        }
+        return true;
+    }
+
+    // Replaces the log with its pending tasks and newest keep_finished_
+    // results, returned in pending and finished, and reopens it for
+    // appending. Payloads are left alone: a task being accepted may have
+    // written its payload but not yet its ACCEPT. Caller holds mutex_.
+    bool rewriteLog(std::vector<PendingEntry>& pending, std::vector<FinishedEntry>& finished) {
+        std::vector<PendingEntry> accepted;
+        std::unordered_map<std::string, size_t> finished_index;
+        std::ifstream input(logPath(), std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        while (input.is_open() && readRecord(input, type, fields, 16)) {
+            PendingEntry entry;
+            if (type == 'A' && parseAccepted(fields, entry)) {
+                accepted.push_back(std::move(entry));
+            } else if (type == 'D' && fields.size() == 3) {
+                finished_index[fields[0]] = finished.size();
+                finished.push_back({fields[0], fields[2], fields[1] == "1"});
+            }
+        }
+        input.close();
+
+        for (const PendingEntry& entry : accepted) {
+            if (!finished_index.count(entry.job_id)) pending.push_back(entry);
+        }
+        if (finished.size() > keep_finished_) {
+            finished.erase(finished.begin(), finished.end() - keep_finished_);
+        }
+
+        const std::string compacted_path = logPath() + ".tmp";
+        FILE* compacted = std::fopen(compacted_path.c_str(), "wb");
+        if (!compacted) return false;
+        for (const PendingEntry& entry : pending) {
+            writeRecord(compacted, 'A', acceptedFields(entry));
+        }
+        for (const FinishedEntry& entry : finished) {
+            writeRecord(compacted, 'D', {entry.job_id, entry.failed ? "1" : "0", entry.text});
+        }
+        std::fflush(compacted);
+        long compacted_bytes = std::ftell(compacted);
+        bool synced = fsync(fileno(compacted)) == 0;
+        std::fclose(compacted);
+        std::error_code error;
+        if (synced) std::filesystem::rename(compacted_path, logPath(), error);
+        if (!synced || error) return false;
+
+        if (log_) std::fclose(log_);
+        log_ = std::fopen(logPath().c_str(), "ab");
+        compact_at_ = std::max(min_compact_bytes_, 2 * compacted_bytes);
+        return log_ != nullptr;
+    }
+
+    static std::vector<std::string> acceptedFields(const PendingEntry& entry) {
+        return {entry.job_id, entry.file_name, entry.language_code, entry.profile_name,
+                entry.batch_id, entry.batch_key, entry.cache_key, entry.form_template,
+                entry.want_word_boxes ? "1" : "0", entry.interactive ? "1" : "0",
+                entry.has_perceptual_hash ? std::to_string(entry.perceptual_hash) : ""};
+    }
+
+    // Logs written before the request options were journaled hold only the
+    // first four fields; those tasks replay with the defaults.
+    static bool parseAccepted(const std::vector<std::string>& fields, PendingEntry& entry) {
+        if (fields.size() != 4 && fields.size() != 11) return false;
+        entry = PendingEntry();
+        entry.job_id = fields[0];
+        entry.file_name = fields[1];
+        entry.language_code = fields[2];
+        entry.profile_name = fields[3];
+        if (fields.size() == 4) return true;
+        entry.batch_id = fields[4];
+        entry.batch_key = fields[5];
+        entry.cache_key = fields[6];
+        entry.form_template = fields[7];
+        entry.want_word_boxes = fields[8] == "1";
+        entry.interactive = fields[9] == "1";
+        if (!fields[10].empty()) {
+            try {
+                entry.perceptual_hash = std::stoull(fields[10]);
+                entry.has_perceptual_hash = true;
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string logPath() const { return directory_ + "/tasks.wal"; }
+    std::string payloadDirectory() const { return directory_ + "/payloads"; }
+
+    // Job ids may come from clients, so payload files are named by hash.
+    std::string payloadPath(const std::string& job_id) const {
+        std::ostringstream path;
+        path << payloadDirectory() << '/' << std::hex << std::setw(16) << std::setfill('0')
+             << contentHash(job_id) << ".img";
+        return path.str();
+    }
+
+    std::string directory_;
+    std::mutex mutex_;
+    FILE* log_;
+    size_t keep_finished_;
+    long min_compact_bytes_;
+    long compact_at_;
+    std::mutex sibling_mutex_;
+    std::unordered_map<std::string, SiblingLog> sibling_logs_;
+};
+
+#endif
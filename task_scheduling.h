@@ -0,0 +1,44 @@
+#ifndef TASK_SCHEDULING_H
+#define TASK_SCHEDULING_H
+
+#include <algorithm>
+#include <chrono>
+
+// Picks within the interactive lane while it has tasks, otherwise within
+// the bulk lane: the oldest task, or with shortest-first the lowest aged
+// cost, the predicted cost less one second per aging interval waited.
+// Queue holds pointers to tasks with `interactive`, `predicted_ms` and
+// `task_start_time`. Tasks for which `runnable` is false are skipped, so a
+// worker passes over work it has no engine for; returns queue.end() when
+// the lane holds nothing runnable.
+template <typename Queue, typename Runnable>
+typename Queue::iterator pickNextTask(Queue& queue, bool interactive_lane, bool shortest_first,
+                                      std::chrono::milliseconds aging,
+                                      std::chrono::steady_clock::time_point now,
+                                      const Runnable& runnable) {
+    const double aging_ms = static_cast<double>(std::max<long long>(1, aging.count()));
+    auto best = queue.end();
+    double best_score = 0.0;
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (interactive_lane && !(*it)->interactive) continue;
+        if (!runnable(*it)) continue;
+        if (!shortest_first) return it;
+        double waited_ms = std::chrono::duration<double, std::milli>(now - (*it)->task_start_time).count();
+        double score = (*it)->predicted_ms - 1000.0 * waited_ms / aging_ms;
+        if (best == queue.end() || score < best_score) {
+            best = it;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+template <typename Queue>
+typename Queue::iterator pickNextTask(Queue& queue, bool interactive_lane, bool shortest_first,
+                                      std::chrono::milliseconds aging,
+                                      std::chrono::steady_clock::time_point now) {
+    return pickNextTask(queue, interactive_lane, shortest_first, aging, now,
+                        [](const typename Queue::value_type&) { return true; });
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "archive_reader.h"
+#include "test_util.h"
+
+// ARCHIVE BUILDERS -----------------------------------------------------------
+static void put16(std::string& out, uint16_t value) {
+    out += static_cast<char>(value & 0xff);
+    out += static_cast<char>(value >> 8);
+}
+
+static void put32(std::string& out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value & 0xffff));
+    put16(out, static_cast<uint16_t>(value >> 16));
+}
+
+static uint32_t crcOf(const std::string& data) {
+    return static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(data.data()),
+                                       static_cast<uInt>(data.size())));
+}
+
+static std::string rawDeflate(const std::string& data) {
+    z_stream stream{};
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// One local header plus data; the sizes can be overridden to build corrupt
+// entries.
+static std::string zipEntry(const std::string& name, const std::string& data, bool deflated,
+                            int64_t compressed_override = -1) {
+    const std::string body = deflated ? rawDeflate(data) : data;
+    std::string out;
+    put32(out, 0x04034b50);
+    put16(out, 20);
+    put16(out, 0);                    // flags
+    put16(out, deflated ? 8 : 0);     // method
+    put32(out, 0);                    // time, date
+    put32(out, crcOf(data));
+    put32(out, compressed_override >= 0 ? static_cast<uint32_t>(compressed_override)
+                                        : static_cast<uint32_t>(body.size()));
+    put32(out, static_cast<uint32_t>(data.size()));
+    put16(out, static_cast<uint16_t>(name.size()));
+    put16(out, 0);
+    out += name;
+    out += body;
+    return out;
+}
+
+static std::string zipEnd() {
+    std::string out;
+    put32(out, 0x06054b50);
+    out.append(18, '\0');
+    return out;
+}
+
+static std::string tarEntry(const std::string& name, const std::string& data) {
+    std::string header(512, '\0');
+    std::memcpy(&header[0], name.data(), name.size());
+    std::snprintf(&header[100], 8, "%07o", 0644);
+    std::snprintf(&header[124], 12, "%011o", static_cast<unsigned>(data.size()));
+    header[156] = '0';
+    std::memcpy(&header[257], "ustar", 6);
+    std::memcpy(&header[263], "00", 2);
+    std::memset(&header[148], ' ', 8);
+    unsigned sum = 0;
+    for (unsigned char byte : header) sum += byte;
+    std::snprintf(&header[148], 8, "%06o", sum);
+    std::string out = header + data;
+    out.append((512 - data.size() % 512) % 512, '\0');
+    return out;
+}
+//----------------------------------------------------------------------------
+
+static std::vector<ArchiveReader::Entry> readAll(const std::string& archive, size_t max_bytes,
+                                                 size_t chunk, bool& ok, bool& complete) {
+    ArchiveReader reader(max_bytes);
+    std::vector<ArchiveReader::Entry> entries;
+    ok = true;
+    for (size_t position = 0; position < archive.size() && ok; position += chunk) {
+        ok = reader.feed(archive.data() + position, std::min(chunk, archive.size() - position), entries);
+    }
+    complete = reader.complete();
+    return entries;
+}
+
+static void zipEntriesInAnyChunking() {
+    const std::string page(5000, 'x');
+    const std::string archive = zipEntry("a.png", "stored bytes", false) +
+                                zipEntry("dir/", "", false) +
+                                zipEntry("b.png", page, true) + zipEnd();
+    for (size_t chunk : {size_t(1), size_t(7), size_t(4096), archive.size()}) {
+        bool ok = false;
+        bool complete = false;
+        auto entries = readAll(archive, 1 << 20, chunk, ok, complete);
+        CHECK(ok);
+        CHECK(complete);
+        CHECK_EQ(entries.size(), 2u);
+        if (entries.size() != 2) continue;
+        CHECK_EQ(entries[0].name, "a.png");
+        CHECK_EQ(entries[0].data, "stored bytes");
+        CHECK(entries[0].error.empty());
+        CHECK_EQ(entries[1].name, "b.png");
+        CHECK(entries[1].data == page);
+    }
+}
+
+// A stored entry whose sizes disagree would be buffered by its compressed
+// size; it is rejected as corrupt instead.
+static void storedSizeMismatch() {
+    const std::string archive = zipEntry("lie.png", "tiny", false, 0x7ffffff0) + zipEnd();
+    bool ok = true;
+    bool complete = false;
+    auto entries = readAll(archive, 1 << 20, archive.size(), ok, complete);
+    CHECK(!ok);
+    CHECK(entries.empty());
+}
+
+static void oversizeEntriesAreSkipped() {
+    const std::string big(3000, 'y');
+    const std::string archive = zipEntry("big.png", big, false) +
+                                zipEntry("small.png", "ok", false) + zipEnd();
+    bool ok = false;
+    bool complete = false;
+    auto entries = readAll(archive, 1000, 64, ok, complete);
+    CHECK(ok);
+    CHECK_EQ(entries.size(), 2u);
+    if (entries.size() == 2) {
+        CHECK_EQ(entries[0].name, "big.png");
+        CHECK(entries[0].data.empty());
+        CHECK(!entries[0].error.empty());
+        CHECK_EQ(entries[1].data, "ok");
+    }
+}
+
+static void crcMismatchIsReported() {
+    std::string archive = zipEntry("bad.png", "payload", false) + zipEnd();
+    archive[30 + 7] ^= 0x01;  // flip a data byte after the name
+    bool ok = false;
+    bool complete = false;
+    auto entries = readAll(archive, 1 << 20, archive.size(), ok, complete);
+    CHECK(ok);
+    CHECK_EQ(entries.size(), 1u);
+    if (entries.size() == 1) CHECK_EQ(entries[0].error, "CRC mismatch");
+}
+
+static void tarEntries() {
+    const std::string archive = tarEntry("one.png", "first") + tarEntry("two.png", std::string(600, 'z')) +
+                                std::string(1024, '\0');
+    for (size_t chunk : {size_t(1), size_t(512), archive.size()}) {
+        bool ok = false;
+        bool complete = false;
+        auto entries = readAll(archive, 1 << 20, chunk, ok, complete);
+        CHECK(ok);
+        CHECK(complete);
+        CHECK_EQ(entries.size(), 2u);
+        if (entries.size() != 2) continue;
+        CHECK_EQ(entries[0].name, "one.png");
+        CHECK_EQ(entries[0].data, "first");
+        CHECK_EQ(entries[1].data.size(), 600u);
+    }
+}
+
+static void unknownFormat() {
+    const std::string garbage(1024, 'g');
+    bool ok = true;
+    bool complete = true;
+    readAll(garbage, 1 << 20, garbage.size(), ok, complete);
+    CHECK(!ok);
+}
+
+int main() {
+    zipEntriesInAnyChunking();
+    storedSizeMismatch();
+    oversizeEntriesAreSkipped();
+    crcMismatchIsReported();
+    tarEntries();
+    unknownFormat();
+    return testResult("archive_reader");
+}
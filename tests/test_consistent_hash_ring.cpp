@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <vector>
+
+#include "consistent_hash_ring.h"
+#include "test_util.h"
+
+static void stableAndSpread() {
+    ConsistentHashRing ring(4);
+    std::vector<int> idle(4, 0);
+    std::vector<int> hits(4, 0);
+    for (uint64_t i = 0; i < 4000; ++i) {
+        const uint64_t key = contentHash(&i, sizeof(i));
+        size_t node = ring.pick(key, idle);
+        CHECK(node < 4);
+        CHECK_EQ(ring.pick(key, idle), node);
+        if (node < 4) hits[node]++;
+    }
+    for (int count : hits) CHECK(count > 200);  // every node owns part of the ring
+}
+
+// Adding a node moves only the keys that now land on it.
+static void minimalRemapping() {
+    ConsistentHashRing three(3);
+    ConsistentHashRing four(4);
+    std::vector<int> idle3(3, 0);
+    std::vector<int> idle4(4, 0);
+    int moved = 0;
+    for (uint64_t i = 0; i < 3000; ++i) {
+        const uint64_t key = contentHash(&i, sizeof(i));
+        size_t before = three.pick(key, idle3);
+        size_t after = four.pick(key, idle4);
+        if (before != after) {
+            CHECK_EQ(after, 3u);
+            ++moved;
+        }
+    }
+    CHECK(moved > 300 && moved < 1300);
+}
+
+// A node at its bounded load passes the key clockwise to the next one.
+static void boundedLoad() {
+    ConsistentHashRing ring(2, 1.0);
+    const uint64_t key = 12345;
+    std::vector<int> idle(2, 0);
+    size_t owner = ring.pick(key, idle);
+    std::vector<int> loaded(2, 0);
+    loaded[owner] = 10;
+    CHECK_EQ(ring.pick(key, loaded), 1 - owner);
+}
+
+static void singleNode() {
+    ConsistentHashRing ring(1);
+    CHECK_EQ(ring.pick(42, std::vector<int>{99}), 0u);
+}
+
+int main() {
+    stableAndSpread();
+    minimalRemapping();
+    boundedLoad();
+    singleNode();
+    return testResult("consistent_hash_ring");
+}
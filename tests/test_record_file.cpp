@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "record_file.h"
+#include "test_util.h"
+
+static std::string tempPath(const char* name) {
+    return std::string(std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp") + "/" + name;
+}
+
+static void roundTrip() {
+    const std::string path = tempPath("ocr_test_records.bin");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    writeRecord(file, 'A', {"first", "", std::string("bin\0ary", 7)});
+    writeRecord(file, 'D', {});
+    std::fclose(file);
+
+    std::ifstream input(path, std::ios::binary);
+    char type = 0;
+    std::vector<std::string> fields;
+    CHECK(readRecord(input, type, fields, 8));
+    CHECK_EQ(type, 'A');
+    CHECK_EQ(fields.size(), 3u);
+    CHECK_EQ(fields[0], "first");
+    CHECK(fields[1].empty());
+    CHECK_EQ(fields[2], std::string("bin\0ary", 7));
+    CHECK(readRecord(input, type, fields, 8));
+    CHECK_EQ(type, 'D');
+    CHECK(fields.empty());
+    CHECK(!readRecord(input, type, fields, 8));
+    std::remove(path.c_str());
+}
+
+// A record cut short by a crash reads as the end of the file.
+static void tornRecord() {
+    const std::string path = tempPath("ocr_test_torn.bin");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    writeRecord(file, 'A', {"kept"});
+    writeRecord(file, 'A', {"torn record"});
+    std::fclose(file);
+    std::string bytes;
+    {
+        std::ifstream input(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 3));
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    char type = 0;
+    std::vector<std::string> fields;
+    CHECK(readRecord(input, type, fields, 8));
+    CHECK_EQ(fields.at(0), "kept");
+    CHECK(!readRecord(input, type, fields, 8));
+    std::remove(path.c_str());
+}
+
+// Corrupt lengths and counts are refused before anything is allocated.
+static void corruptLengths() {
+    const std::string path = tempPath("ocr_test_corrupt.bin");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputc('A', file);
+    writeU32(file, 1);
+    writeU32(file, 0x7fffffffu);  // far beyond the bytes that follow
+    std::fputs("short", file);
+    std::fclose(file);
+    {
+        std::ifstream input(path, std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        CHECK(!readRecord(input, type, fields, 8));
+    }
+
+    file = std::fopen(path.c_str(), "wb");
+    std::fputc('A', file);
+    writeU32(file, 1);
+    writeU32(file, kMaxRecordFieldBytes + 1);
+    std::fclose(file);
+    {
+        std::ifstream input(path, std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        CHECK(!readRecord(input, type, fields, 8));
+    }
+
+    file = std::fopen(path.c_str(), "wb");
+    writeRecord(file, 'A', {"a", "b", "c"});
+    std::fclose(file);
+    {
+        std::ifstream input(path, std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        CHECK(!readRecord(input, type, fields, 2));
+    }
+    std::remove(path.c_str());
+}
+
+int main() {
+    roundTrip();
+    tornRecord();
+    corruptLengths();
+    return testResult("record_file");
+}
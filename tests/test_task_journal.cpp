@@ -0,0 +1,207 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "task_journal.h"
+#include "test_util.h"
+
+static std::string makeDirectory() {
+    std::string pattern = (std::filesystem::temp_directory_path() / "ocr_journal_XXXXXX").string();
+    char* created = mkdtemp(&pattern[0]);
+    return created ? std::string(created) : std::string();
+}
+
+static TaskJournal::PendingEntry sampleEntry(const std::string& job_id) {
+    TaskJournal::PendingEntry entry;
+    entry.job_id = job_id;
+    entry.file_name = "page.png";
+    entry.language_code = "eng";
+    entry.profile_name = "fast";
+    entry.batch_id = "batch-7";
+    entry.batch_key = "client/batch-7";
+    entry.cache_key = "fast:0123abcd";
+    entry.form_template = "invoice";
+    entry.want_word_boxes = true;
+    entry.interactive = false;
+    entry.has_perceptual_hash = true;
+    entry.perceptual_hash = 0xfedcba9876543210ULL;
+    return entry;
+}
+
+// Accepted tasks come back from recover() with every request option.
+static void replaysPendingTasks(const std::string& directory) {
+    const std::vector<unsigned char> image = {1, 2, 3, 0, 255};
+    {
+        TaskJournal journal(directory);
+        std::vector<TaskJournal::PendingEntry> pending;
+        std::vector<TaskJournal::FinishedEntry> finished;
+        CHECK(journal.recover(pending, finished, 10));
+        CHECK(pending.empty());
+        CHECK(journal.recordAccepted(sampleEntry("job-1"), image));
+        CHECK(journal.recordAccepted(sampleEntry("job-2"), image));
+        journal.recordFinished("job-2", "done text", false);
+    }
+
+    TaskJournal journal(directory);
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    CHECK(journal.recover(pending, finished, 10));
+    CHECK_EQ(pending.size(), 1u);
+    CHECK_EQ(finished.size(), 1u);
+    if (pending.size() == 1) {
+        const TaskJournal::PendingEntry expected = sampleEntry("job-1");
+        const TaskJournal::PendingEntry& entry = pending[0];
+        CHECK_EQ(entry.job_id, expected.job_id);
+        CHECK_EQ(entry.file_name, expected.file_name);
+        CHECK_EQ(entry.language_code, expected.language_code);
+        CHECK_EQ(entry.profile_name, expected.profile_name);
+        CHECK_EQ(entry.batch_id, expected.batch_id);
+        CHECK_EQ(entry.batch_key, expected.batch_key);
+        CHECK_EQ(entry.cache_key, expected.cache_key);
+        CHECK_EQ(entry.form_template, expected.form_template);
+        CHECK_EQ(entry.want_word_boxes, expected.want_word_boxes);
+        CHECK_EQ(entry.interactive, expected.interactive);
+        CHECK_EQ(entry.has_perceptual_hash, expected.has_perceptual_hash);
+        CHECK_EQ(entry.perceptual_hash, expected.perceptual_hash);
+    }
+    if (finished.size() == 1) {
+        CHECK_EQ(finished[0].job_id, "job-2");
+        CHECK_EQ(finished[0].text, "done text");
+        CHECK(!finished[0].failed);
+    }
+    std::vector<unsigned char> payload;
+    CHECK(journal.loadPayload("job-1", payload));
+    CHECK(payload == image);
+    CHECK(!journal.loadPayload("job-2", payload));  // dropped once finished
+}
+
+// Compaction keeps only the newest finished results.
+static void keepsNewestFinished(const std::string& directory) {
+    {
+        TaskJournal journal(directory);
+        std::vector<TaskJournal::PendingEntry> pending;
+        std::vector<TaskJournal::FinishedEntry> finished;
+        CHECK(journal.recover(pending, finished, 10));
+        for (int i = 0; i < 5; ++i) {
+            journal.recordFinished("done-" + std::to_string(i), "text", i % 2 == 1);
+        }
+    }
+    TaskJournal journal(directory);
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    CHECK(journal.recover(pending, finished, 2));
+    CHECK_EQ(finished.size(), 2u);
+    if (finished.size() == 2) {
+        CHECK_EQ(finished[0].job_id, "done-3");
+        CHECK(finished[0].failed);
+        CHECK_EQ(finished[1].job_id, "done-4");
+    }
+}
+
+// A running journal rewrites its log once it has doubled past the
+// threshold, keeping pending tasks and their payloads.
+static void compactsWhileRunning(const std::string& directory) {
+    const std::vector<unsigned char> image = {7, 7, 7};
+    const std::string text(200, 'x');
+    {
+        TaskJournal journal(directory, 4096);
+        std::vector<TaskJournal::PendingEntry> pending;
+        std::vector<TaskJournal::FinishedEntry> finished;
+        CHECK(journal.recover(pending, finished, 3));
+        CHECK(journal.recordAccepted(sampleEntry("waiting"), image));
+        for (int i = 0; i < 200; ++i) {
+            const std::string job_id = "job-" + std::to_string(i);
+            CHECK(journal.recordAccepted(sampleEntry(job_id), image));
+            journal.recordFinished(job_id, text, false);
+        }
+        CHECK(std::filesystem::file_size(directory + "/tasks.wal") < 8192u);
+        std::vector<unsigned char> payload;
+        CHECK(journal.loadPayload("waiting", payload));
+        CHECK(!journal.loadPayload("job-0", payload));
+
+        // Payloads left behind by a failed sync go at the next recover().
+        std::FILE* orphan = std::fopen((directory + "/payloads/orphan.img").c_str(), "wb");
+        CHECK(orphan != nullptr);
+        if (orphan) std::fclose(orphan);
+    }
+
+    TaskJournal journal(directory, 4096);
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    CHECK(journal.recover(pending, finished, 3));
+    CHECK_EQ(pending.size(), 1u);
+    if (pending.size() == 1) CHECK_EQ(pending[0].job_id, "waiting");
+    CHECK_EQ(finished.size(), 3u);
+    if (!finished.empty()) CHECK_EQ(finished.back().job_id, "job-199");
+    CHECK(!std::filesystem::exists(directory + "/payloads/orphan.img"));
+    std::vector<unsigned char> payload;
+    CHECK(journal.loadPayload("waiting", payload));
+}
+
+// A prefork slot finds jobs accepted and finished by another slot, also
+// after that slot has compacted its log.
+static void findsJobsInSiblings(const std::string& root) {
+    const std::vector<unsigned char> image = {1};
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    TaskJournal first(root + "/slot-0");
+    TaskJournal second(root + "/slot-1", 1024);
+    CHECK(first.recover(pending, finished, 10));
+    CHECK(second.recover(pending, finished, 10));
+
+    TaskJournal::FinishedEntry result;
+    CHECK(first.findInSiblings("remote", result) == TaskJournal::SiblingJob::Unknown);
+    CHECK(second.recordAccepted(sampleEntry("remote"), image));
+    CHECK(first.findInSiblings("remote", result) == TaskJournal::SiblingJob::Pending);
+    second.recordFinished("remote", "remote text", false);
+    CHECK(first.findInSiblings("remote", result) == TaskJournal::SiblingJob::Finished);
+    CHECK_EQ(result.text, "remote text");
+    CHECK(!result.failed);
+
+    // Enough results to make slot-1 rewrite its log under the reader.
+    for (int i = 0; i < 20; ++i) {
+        second.recordFinished("filler-" + std::to_string(i), std::string(100, 'x'), false);
+    }
+    second.recordFinished("late", "late text", true);
+    CHECK(first.findInSiblings("late", result) == TaskJournal::SiblingJob::Finished);
+    CHECK_EQ(result.text, "late text");
+    CHECK(result.failed);
+    CHECK(first.findInSiblings("local", result) == TaskJournal::SiblingJob::Unknown);
+}
+
+// ACCEPT records written before the request options were journaled.
+static void readsLegacyRecords(const std::string& directory) {
+    std::filesystem::create_directories(directory);
+    FILE* log = std::fopen((directory + "/tasks.wal").c_str(), "wb");
+    writeRecord(log, 'A', {"old-job", "scan.tif", "deu", "default"});
+    std::fclose(log);
+
+    TaskJournal journal(directory);
+    std::vector<TaskJournal::PendingEntry> pending;
+    std::vector<TaskJournal::FinishedEntry> finished;
+    CHECK(journal.recover(pending, finished, 10));
+    CHECK_EQ(pending.size(), 1u);
+    if (pending.size() == 1) {
+        CHECK_EQ(pending[0].job_id, "old-job");
+        CHECK_EQ(pending[0].language_code, "deu");
+        CHECK(pending[0].batch_id.empty());
+        CHECK(pending[0].interactive);
+        CHECK(!pending[0].has_perceptual_hash);
+    }
+}
+
+int main() {
+    const std::string root = makeDirectory();
+    CHECK(!root.empty());
+    if (root.empty()) return testResult("task_journal");
+    replaysPendingTasks(root + "/replay");
+    keepsNewestFinished(root + "/compact");
+    compactsWhileRunning(root + "/running");
+    findsJobsInSiblings(root + "/prefork");
+    readsLegacyRecords(root + "/legacy");
+    std::error_code error;
+    std::filesystem::remove_all(root, error);
+    return testResult("task_journal");
+}
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "task_scheduling.h"
+#include "test_util.h"
+
+struct FakeTask {
+    std::string name;
+    std::string profile = "default";
+    bool interactive = false;
+    double predicted_ms = 0.0;
+    std::chrono::steady_clock::time_point task_start_time;
+};
+
+using Queue = std::deque<std::shared_ptr<FakeTask>>;
+
+static const auto kNow = std::chrono::steady_clock::now();
+
+static std::shared_ptr<FakeTask> task(const std::string& name, bool interactive, double predicted_ms,
+                                      int waited_ms) {
+    auto queued = std::make_shared<FakeTask>();
+    queued->name = name;
+    queued->interactive = interactive;
+    queued->predicted_ms = predicted_ms;
+    queued->task_start_time = kNow - std::chrono::milliseconds(waited_ms);
+    return queued;
+}
+
+static std::string pick(Queue& queue, bool interactive_lane, bool shortest_first,
+                        int aging_ms = 500) {
+    auto it = pickNextTask(queue, interactive_lane, shortest_first,
+                           std::chrono::milliseconds(aging_ms), kNow);
+    return it == queue.end() ? "" : (*it)->name;
+}
+
+static void fifo() {
+    Queue queue = {task("old", false, 900, 50), task("new", false, 10, 0)};
+    CHECK_EQ(pick(queue, false, false), "old");
+}
+
+static void interactiveLaneFirst() {
+    Queue queue = {task("bulk", false, 10, 100), task("ui-1", true, 500, 10),
+                   task("ui-2", true, 100, 0)};
+    CHECK_EQ(pick(queue, true, false), "ui-1");
+    CHECK_EQ(pick(queue, true, true), "ui-2");
+    CHECK_EQ(pick(queue, false, true), "bulk");
+}
+
+static void shortestFirst() {
+    Queue queue = {task("large", false, 4000, 0), task("small", false, 200, 0),
+                   task("medium", false, 1000, 0)};
+    CHECK_EQ(pick(queue, false, true), "small");
+}
+
+// Each aging interval waited takes one second off the predicted cost, so a
+// large page overtakes fresh small ones eventually.
+static void agingPromotesWaitingTasks() {
+    Queue queue = {task("large", false, 4000, 2500), task("small", false, 200, 0)};
+    CHECK_EQ(pick(queue, false, true, 500), "large");   // 4000 - 5000 < 200
+    CHECK_EQ(pick(queue, false, true, 1000), "small");  // 4000 - 2500 > 200
+}
+
+static void emptyLane() {
+    Queue queue = {task("bulk", false, 10, 0)};
+    CHECK_EQ(pick(queue, true, true), "");
+    Queue empty;
+    CHECK_EQ(pick(empty, false, false), "");
+}
+
+// A worker without an engine for a profile passes over its tasks, in either
+// lane and in either order.
+static void skipsUnservableProfiles() {
+    Queue queue = {task("fast-ui", true, 10, 50), task("best-ui", true, 500, 0),
+                   task("fast-bulk", false, 10, 50), task("best-bulk", false, 900, 0)};
+    queue[0]->profile = queue[2]->profile = "fast";
+    queue[1]->profile = queue[3]->profile = "best";
+    const std::set<std::string> engines = {"best"};
+    auto runnable = [&](const std::shared_ptr<FakeTask>& queued) {
+        return engines.count(queued->profile) > 0;
+    };
+    auto name = [&](Queue::iterator it) { return it == queue.end() ? "" : (*it)->name; };
+    const auto aging = std::chrono::milliseconds(500);
+    CHECK_EQ(name(pickNextTask(queue, true, false, aging, kNow, runnable)), "best-ui");
+    CHECK_EQ(name(pickNextTask(queue, true, true, aging, kNow, runnable)), "best-ui");
+
+    queue.erase(queue.begin() + 1);
+    CHECK_EQ(name(pickNextTask(queue, true, true, aging, kNow, runnable)), "");
+    CHECK_EQ(name(pickNextTask(queue, false, false, aging, kNow, runnable)), "best-bulk");
+    CHECK_EQ(name(pickNextTask(queue, false, true, aging, kNow, runnable)), "best-bulk");
+}
+
+int main() {
+    fifo();
+    interactiveLaneFirst();
+    shortestFirst();
+    agingPromotesWaitingTasks();
+    emptyLane();
+    skipsUnservableProfiles();
+    return testResult("task_scheduling");
+}
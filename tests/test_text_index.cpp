@@ -0,0 +1,86 @@
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+#include "text_index.h"
+
+static std::string makeDirectory() {
+    std::string pattern = (std::filesystem::temp_directory_path() / "ocr_index_XXXXXX").string();
+    char* created = mkdtemp(&pattern[0]);
+    return created ? std::string(created) : std::string();
+}
+
+static std::set<std::string> jobIds(const std::vector<TextIndex::Match>& matches) {
+    std::set<std::string> ids;
+    for (const auto& match : matches) ids.insert(match.job_id);
+    return ids;
+}
+
+// Pages indexed by two prefork slots are found from either slot, including
+// pages added after the searching slot opened its index.
+static void searchesEverySlot(const std::string& root) {
+    TextIndex first(root + "/slot-0");
+    TextIndex second(root + "/slot-1");
+    CHECK(first.open());
+    CHECK(second.open());
+
+    first.addDocument("0-1", "batch-a", "invoice.png", "Invoice total 42 EUR");
+    second.addDocument("1-1", "batch-b", "receipt.png", "Receipt total 17 EUR");
+
+    size_t total = 0;
+    std::vector<TextIndex::Match> matches = first.search("total eur", "", 10, total);
+    CHECK_EQ(total, 2u);
+    CHECK(jobIds(matches) == std::set<std::string>({"0-1", "1-1"}));
+
+    matches = second.search("TOTAL", "", 10, total);
+    CHECK_EQ(total, 2u);
+    CHECK(jobIds(matches) == std::set<std::string>({"0-1", "1-1"}));
+
+    matches = first.search("total", "batch-b", 10, total);
+    CHECK_EQ(total, 1u);
+    CHECK(jobIds(matches) == std::set<std::string>({"1-1"}));
+
+    // Each slot counts only what it wrote itself.
+    CHECK_EQ(first.documentCount(), 1u);
+    CHECK_EQ(second.documentCount(), 1u);
+}
+
+// A restarted slot reloads its own log and the other slots' logs.
+static void reloadsEverySlot(const std::string& root) {
+    {
+        TextIndex first(root + "/slot-0");
+        TextIndex second(root + "/slot-1");
+        CHECK(first.open());
+        CHECK(second.open());
+        first.addDocument("0-1", "", "a.png", "alpha beta");
+        second.addDocument("1-1", "", "b.png", "beta gamma");
+    }
+    TextIndex reopened(root + "/slot-0");
+    CHECK(reopened.open());
+    CHECK_EQ(reopened.documentCount(), 1u);
+
+    size_t total = 0;
+    std::vector<TextIndex::Match> matches = reopened.search("beta", "", 10, total);
+    CHECK_EQ(total, 2u);
+    matches = reopened.search("gamma", "", 10, total);
+    CHECK_EQ(total, 1u);
+    if (matches.size() == 1) {
+        CHECK_EQ(matches[0].job_id, "1-1");
+        CHECK_EQ(matches[0].file_name, "b.png");
+        CHECK(matches[0].positions == std::vector<uint32_t>({1}));
+    }
+}
+
+int main() {
+    const std::string root = makeDirectory();
+    CHECK(!root.empty());
+    if (root.empty()) return testResult("text_index");
+    searchesEverySlot(root + "/live");
+    reloadsEverySlot(root + "/restart");
+    std::error_code error;
+    std::filesystem::remove_all(root, error);
+    return testResult("text_index");
+}
@@ -0,0 +1,35 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Minimal checks for the standalone test executables: each failed CHECK is
+// reported and the test exits non-zero at the end, so ctest lists it.
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" \
+                      << std::endl;                                                   \
+            ++testFailures();                                                         \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CHECK((actual) == (expected))
+
+inline int testResult(const char* name) {
+    if (testFailures() == 0) {
+        std::cout << name << ": all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << name << ": " << testFailures() << " check(s) failed" << std::endl;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "record_file.h"
+
+// Inverted index of recognized text: token -> documents (job ids) with token
+// positions. Each finished document is appended to index.log as one record
+// holding its postings, so the index grows incrementally and is rebuilt at
+// startup without re-tokenizing anything.
+//
+// In prefork mode every process writes its own slot-N directory. The logs of
+// sibling slot-* directories are tailed read-only before each search, so a
+// query sees the pages recognized by every process.
+class TextIndex {
+public:
+    struct Match {
+        std::string job_id;
+        std::string batch_id;
+        std::string file_name;
+        std::vector<uint32_t> positions;
+    };
+
+    explicit TextIndex(const std::string& directory)
+        : directory_(directory), log_(nullptr), local_documents_(0) {}
+
+    ~TextIndex() {
+        if (log_) std::fclose(log_);
+    }
+
+    TextIndex(const TextIndex&) = delete;
+    TextIndex& operator=(const TextIndex&) = delete;
+
+    bool enabled() const { return !directory_.empty(); }
+
+    bool open() {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) return false;
+
+        std::ifstream input(logPath(), std::ios::binary);
+        char type = 0;
+        std::vector<std::string> fields;
+        while (input.is_open() && readRecord(input, type, fields, kMaxRecordFields)) {
+            if (addRecord(type, fields)) ++local_documents_;
+        }
+        input.close();
+
+        log_ = std::fopen(logPath().c_str(), "ab");
+        if (!log_) return false;
+        readSiblingLogs();
+        return true;
+    }
+
+    void addDocument(const std::string& job_id, const std::string& batch_id,
+                     const std::string& file_name, const std::string& text) {
+        if (!log_ || job_id.empty()) return;
+
+        std::unordered_map<std::string, std::vector<uint32_t>> postings;
+        std::vector<std::string> tokens = tokenize(text);
+        for (uint32_t position = 0; position < tokens.size(); ++position) {
+            postings[tokens[position]].push_back(position);
+        }
+
+        std::unique_lock<std::shared_mutex> guard(mutex_);
+        if (document_ids_.count(job_id)) return;
+        addToMemory(job_id, batch_id, file_name, postings);
+        ++local_documents_;
+
+        std::vector<std::string> fields = {job_id, batch_id, file_name};
+        for (const auto& posting : postings) {
+            fields.push_back(posting.first);
+            fields.push_back(encodePositions(posting.second));
+        }
+        writeRecord(log_, 'I', fields);
+        std::fflush(log_);
+    }
+
+    // Documents containing every query token, oldest first within each slot.
+    // positions holds the positions of all query tokens in the document,
+    // sorted.
+    std::vector<Match> search(const std::string& query, const std::string& batch_id,
+                              size_t limit, size_t& total_matches) {
+        std::vector<Match> matches;
+        total_matches = 0;
+        std::vector<std::string> terms = tokenize(query);
+        if (terms.empty()) return matches;
+
+        readSiblingLogs();
+
+        std::shared_lock<std::shared_mutex> guard(mutex_);
+        std::vector<const std::vector<Posting>*> lists;
+        for (const std::string& term : terms) {
+            auto it = postings_.find(term);
+            if (it == postings_.end()) return matches;
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+            return a->size() < b->size();
+        });
+
+        for (const Posting& candidate : *lists.front()) {
+            const Document& document = documents_[candidate.document];
+            if (!batch_id.empty() && document.batch_id != batch_id) continue;
+
+            std::vector<uint32_t> positions = candidate.positions;
+            bool in_all = true;
+            for (size_t i = 1; i < lists.size() && in_all; ++i) {
+                auto found = std::lower_bound(lists[i]->begin(), lists[i]->end(), candidate.document,
+                    [](const Posting& posting, uint32_t document_id) {
+                        return posting.document < document_id;
+                    });
+                in_all = found != lists[i]->end() && found->document == candidate.document;
+                if (in_all) positions.insert(positions.end(), found->positions.begin(),
+                                             found->positions.end());
+            }
+            if (!in_all) continue;
+
+            ++total_matches;
+            if (matches.size() >= limit) continue;
+            std::sort(positions.begin(), positions.end());
+            positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+            matches.push_back({document.job_id, document.batch_id, document.file_name, positions});
+        }
+        return matches;
+    }
+
+    // Documents written by this slot; the other slots report their own, so
+    // the per-slot counts add up in GetStats.
+    size_t documentCount() {
+        std::shared_lock<std::shared_mutex> guard(mutex_);
+        return local_documents_;
+    }
+
+    // Lowercased runs of ASCII letters and digits; bytes of multi-byte UTF-8
+    // sequences count as token characters so non-Latin words stay whole.
+    static std::vector<std::string> tokenize(const std::string& text) {
+        std::vector<std::string> tokens;
+        std::string current;
+        for (unsigned char ch : text) {
+            if (std::isalnum(ch) || ch >= 0x80) {
+                if (current.size() < kMaxTokenLength) {
+                    current.push_back(static_cast<char>(std::tolower(ch)));
+                }
+            } else if (!current.empty()) {
+                tokens.push_back(std::move(current));
+                current.clear();
+            }
+        }
+        if (!current.empty()) tokens.push_back(std::move(current));
+        return tokens;
+    }
+
+private:
+    struct Document {
+        std::string job_id;
+        std::string batch_id;
+        std::string file_name;
+    };
+
+    struct Posting {
+        uint32_t document;
+        std::vector<uint32_t> positions;
+    };
+
+    static constexpr size_t kMaxTokenLength = 64;
+    static constexpr uint32_t kMaxRecordFields = 1u << 22;
+
+    std::string logPath() const { return directory_ + "/index.log"; }
+
+    // Loads the records appended to sibling slot-*/index.log files since the
+    // last call. Each log is read from the end of its last complete record,
+    // so a record still being written is picked up by a later call.
+    void readSiblingLogs() {
+        std::filesystem::path own(directory_);
+        std::filesystem::path root = own.parent_path();
+        if (root.empty()) root = ".";
+        const std::string own_name = own.filename().string();
+
+        std::vector<std::string> logs;
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(root, error), end; !error && it != end;
+             it.increment(error)) {
+            const std::string name = it->path().filename().string();
+            if (name == own_name || name.compare(0, 5, "slot-") != 0) continue;
+            logs.push_back((it->path() / "index.log").string());
+        }
+
+        std::lock_guard<std::mutex> sibling_guard(sibling_mutex_);
+        for (const std::string& path : logs) {
+            std::streamoff& offset = sibling_offsets_[path];
+            std::error_code size_error;
+            uintmax_t size = std::filesystem::file_size(path, size_error);
+            if (size_error || static_cast<std::streamoff>(size) <= offset) continue;
+
+            std::ifstream input(path, std::ios::binary);
+            if (!input.is_open()) continue;
+            input.seekg(offset);
+            char type = 0;
+            std::vector<std::string> fields;
+            std::unique_lock<std::shared_mutex> guard(mutex_);
+            while (readRecord(input, type, fields, kMaxRecordFields)) {
+                offset = input.tellg();
+                addRecord(type, fields);
+            }
+        }
+    }
+
+    // Caller holds the write lock (or is the single-threaded loader).
+    bool addRecord(char type, const std::vector<std::string>& fields) {
+        if (type != 'I' || fields.size() < 3 || (fields.size() - 3) % 2 != 0) return false;
+        std::unordered_map<std::string, std::vector<uint32_t>> postings;
+        for (size_t i = 3; i < fields.size(); i += 2) {
+            postings[fields[i]] = decodePositions(fields[i + 1]);
+        }
+        return addToMemory(fields[0], fields[1], fields[2], postings);
+    }
+
+    // Caller holds the write lock (or is the single-threaded loader).
+    bool addToMemory(const std::string& job_id, const std::string& batch_id,
+                     const std::string& file_name,
+                     const std::unordered_map<std::string, std::vector<uint32_t>>& postings) {
+        if (!document_ids_.insert(job_id).second) return false;
+        uint32_t document = static_cast<uint32_t>(documents_.size());
+        documents_.push_back({job_id, batch_id, file_name});
+        for (const auto& posting : postings) {
+            postings_[posting.first].push_back({document, posting.second});
+        }
+        return true;
+    }
+
+    static std::string encodePositions(const std::vector<uint32_t>& positions) {
+        std::string encoded;
+        for (uint32_t position : positions) {
+            if (!encoded.empty()) encoded.push_back(',');
+            encoded += std::to_string(position);
+        }
+        return encoded;
+    }
+
+    static std::vector<uint32_t> decodePositions(const std::string& encoded) {
+        std::vector<uint32_t> positions;
+        std::stringstream stream(encoded);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            try {
+                positions.push_back(static_cast<uint32_t>(std::stoul(item)));
+            } catch (...) {}
+        }
+        return positions;
+    }
+
+    std::string directory_;
+    FILE* log_;
+    std::shared_mutex mutex_;
+    std::vector<Document> documents_;
+    std::set<std::string> document_ids_;
+    std::unordered_map<std::string, std::vector<Posting>> postings_;
+    size_t local_documents_;
+    std::mutex sibling_mutex_;
+    std::map<std::string, std::streamoff> sibling_offsets_;
+};
+
+#endif